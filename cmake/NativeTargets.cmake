@@ -75,6 +75,12 @@ add_custom_target(tests-radio
   DEPENDS gtests-radio
   )
 
+# host benchmarks
+add_custom_target(benchmarks-radio
+  COMMAND ${CMAKE_CURRENT_BINARY_DIR}/bench-radio
+  DEPENDS bench-radio
+  )
+
 if(Qt5Core_FOUND AND NOT DISABLE_COMPANION)
   add_subdirectory(${COMPANION_SRC_DIRECTORY})
   add_custom_target(tests-companion
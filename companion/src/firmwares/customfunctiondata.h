@@ -107,6 +107,7 @@ class CustomFunctionData {
     unsigned int enabled; // TODO perhaps not any more the right name
     unsigned int adjustMode;
     int repeatParam;
+    unsigned int logsHighRate;  // in 10ms, 0 when disabled
 
     void convert(RadioDataConversionState & cstate);
 
@@ -223,6 +223,11 @@ Node convert<CustomFunctionData>::encode(const CustomFunctionData& rhs)
 
   def += std::to_string((int)rhs.enabled);
 
+  if (rhs.func == FuncLogs && rhs.logsHighRate) {
+    def += ",";
+    def += std::to_string(rhs.logsHighRate);
+  }
+
   if(fnHasRepeat(rhs.func)) {
     def += ",";
 
@@ -401,6 +406,13 @@ bool convert<CustomFunctionData>::decode(const Node& node,
     rhs.enabled = en[0] == '1' ? 1 : 0;
   }
 
+  if (rhs.func == FuncLogs && !repeat.empty()) {
+    // optional high rate period
+    try {
+      rhs.logsHighRate = std::stoi(repeat);
+    } catch(...) {}
+  }
+
   if(fnHasRepeat(rhs.func)) {
     if (rhs.func == FuncPlayScript || rhs.func == FuncRGBLed) {
       rhs.repeatParam = (repeat == "1x") ? 1 : 0;
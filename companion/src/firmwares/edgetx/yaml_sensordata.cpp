@@ -102,6 +102,7 @@ Node convert<SensorData>::encode(const SensorData& rhs)
   node["logs"] = (int)rhs.logs;
   node["persistent"] = (int)rhs.persistent;
   node["onlyPositive"] = (int)rhs.onlyPositive;
+  node["logsHighRate"] = (int)rhs.logsHighRate;
 
   if (cfg && cfg.IsMap()) {
     node["cfg"] = cfg;
@@ -137,6 +138,7 @@ bool convert<SensorData>::decode(const Node& node, SensorData& rhs)
   node["logs"] >> rhs.logs;
   node["persistent"] >> rhs.persistent;
   node["onlyPositive"] >> rhs.onlyPositive;
+  node["logsHighRate"] >> rhs.logsHighRate;
 
   if (node["cfg"]) {
     Node cfg = node["cfg"];
@@ -160,6 +160,7 @@ class SensorData {
     bool logs;
     bool persistent;
     bool onlyPositive;
+    bool logsHighRate;
 
     // for custom sensors
     unsigned int ratio;
@@ -22,6 +22,7 @@
 #include <math.h>
 
 #include "opentx.h"
+#include "audio_mix.h"
 #include "strhelpers.h"
 #include "switches.h"
 
@@ -33,7 +34,7 @@
 
 extern RTOS_MUTEX_HANDLE audioMutex;
 
-const int16_t sineValues[] =
+const int16_t sineValues[AUDIO_SINE_SIZE] =
 {
     0, 196, 392, 588, 784, 980, 1175, 1370, 1564, 1758,
     1951, 2143, 2335, 2525, 2715, 2904, 3091, 3278, 3463, 3647,
@@ -140,6 +141,158 @@ const int16_t sineValues[] =
     -784, -588, -392, -196,
 };
 
+// Polyphase windowed-sinc (Kaiser) low-pass, cut-off at 0.45 of the
+// source rate, one row per fractional position, Q14
+const int16_t resamplerTaps[AUDIO_RESAMPLER_PHASES][AUDIO_RESAMPLER_TAPS] =
+{
+  {    230,   -739,   1352,  14716,   1352,   -739,    230,    -18 },
+  {    223,   -709,   1247,  14715,   1459,   -769,    237,    -19 },
+  {    216,   -679,   1143,  14711,   1568,   -799,    244,    -20 },
+  {    209,   -650,   1040,  14706,   1678,   -829,    251,    -21 },
+  {    202,   -621,    940,  14698,   1789,   -859,    257,    -22 },
+  {    196,   -592,    840,  14687,   1902,   -890,    264,    -23 },
+  {    189,   -563,    743,  14672,   2016,   -920,    271,    -24 },
+  {    182,   -535,    646,  14657,   2131,   -951,    278,    -24 },
+  {    176,   -506,    552,  14635,   2248,   -981,    285,    -25 },
+  {    169,   -478,    459,  14613,   2367,  -1012,    292,    -26 },
+  {    163,   -451,    367,  14589,   2486,  -1042,    299,    -27 },
+  {    156,   -423,    278,  14561,   2607,  -1073,    306,    -28 },
+  {    150,   -396,    190,  14530,   2729,  -1103,    313,    -29 },
+  {    143,   -369,    103,  14499,   2852,  -1134,    320,    -30 },
+  {    137,   -343,     19,  14463,   2976,  -1164,    327,    -31 },
+  {    131,   -316,    -64,  14425,   3102,  -1195,    333,    -32 },
+  {    125,   -290,   -146,  14385,   3228,  -1225,    340,    -33 },
+  {    119,   -265,   -225,  14341,   3356,  -1255,    347,    -34 },
+  {    113,   -240,   -303,  14296,   3485,  -1285,    353,    -35 },
+  {    107,   -215,   -380,  14247,   3614,  -1314,    360,    -35 },
+  {    102,   -190,   -454,  14195,   3745,  -1344,    366,    -36 },
+  {     96,   -166,   -527,  14142,   3877,  -1373,    372,    -37 },
+  {     91,   -143,   -598,  14086,   4009,  -1402,    379,    -38 },
+  {     85,   -119,   -667,  14027,   4143,  -1431,    385,    -39 },
+  {     80,    -97,   -735,  13967,   4277,  -1459,    391,    -40 },
+  {     75,    -74,   -801,  13904,   4412,  -1487,    396,    -41 },
+  {     70,    -52,   -865,  13838,   4548,  -1515,    402,    -42 },
+  {     65,    -30,   -928,  13768,   4685,  -1542,    408,    -42 },
+  {     60,     -9,   -988,  13698,   4822,  -1569,    413,    -43 },
+  {     55,     11,  -1047,  13627,   4960,  -1596,    418,    -44 },
+  {     50,     32,  -1105,  13552,   5098,  -1622,    424,    -45 },
+  {     45,     52,  -1160,  13475,   5237,  -1648,    429,    -46 },
+  {     41,     71,  -1214,  13395,   5377,  -1673,    433,    -46 },
+  {     37,     90,  -1266,  13313,   5517,  -1698,    438,    -47 },
+  {     32,    109,  -1316,  13229,   5658,  -1722,    442,    -48 },
+  {     28,    127,  -1365,  13142,   5799,  -1746,    447,    -48 },
+  {     24,    144,  -1412,  13055,   5940,  -1769,    451,    -49 },
+  {     20,    161,  -1457,  12965,   6082,  -1791,    454,    -50 },
+  {     16,    178,  -1501,  12872,   6224,  -1813,    458,    -50 },
+  {     13,    194,  -1543,  12778,   6366,  -1834,    461,    -51 },
+  {      9,    210,  -1583,  12680,   6509,  -1855,    465,    -51 },
+  {      6,    225,  -1621,  12582,   6651,  -1875,    467,    -51 },
+  {      2,    240,  -1658,  12482,   6794,  -1894,    470,    -52 },
+  {     -1,    255,  -1694,  12379,   6937,  -1912,    472,    -52 },
+  {     -4,    268,  -1727,  12275,   7079,  -1930,    475,    -52 },
+  {     -7,    282,  -1759,  12169,   7222,  -1946,    476,    -53 },
+  {    -10,    295,  -1790,  12061,   7365,  -1962,    478,    -53 },
+  {    -13,    307,  -1818,  11952,   7507,  -1977,    479,    -53 },
+  {    -16,    319,  -1846,  11842,   7650,  -1992,    480,    -53 },
+  {    -18,    331,  -1871,  11727,   7792,  -2005,    481,    -53 },
+  {    -21,    342,  -1896,  11614,   7934,  -2017,    481,    -53 },
+  {    -23,    353,  -1918,  11497,   8075,  -2029,    482,    -53 },
+  {    -26,    363,  -1939,  11381,   8216,  -2039,    481,    -53 },
+  {    -28,    373,  -1959,  11262,   8357,  -2049,    481,    -53 },
+  {    -30,    382,  -1977,  11140,   8498,  -2057,    480,    -52 },
+  {    -32,    391,  -1994,  11019,   8638,  -2065,    479,    -52 },
+  {    -34,    399,  -2009,  10897,   8777,  -2071,    477,    -52 },
+  {    -36,    407,  -2023,  10772,   8916,  -2076,    475,    -51 },
+  {    -37,    415,  -2035,  10645,   9054,  -2080,    473,    -51 },
+  {    -39,    422,  -2046,  10519,   9191,  -2083,    470,    -50 },
+  {    -40,    428,  -2055,  10390,   9328,  -2085,    467,    -49 },
+  {    -42,    435,  -2064,  10261,   9464,  -2086,    464,    -48 },
+  {    -43,    441,  -2071,  10130,   9599,  -2085,    460,    -47 },
+  {    -44,    446,  -2076,   9998,   9734,  -2083,    456,    -47 },
+  {    -45,    451,  -2080,   9867,   9865,  -2080,    451,    -45 },
+  {    -47,    456,  -2083,   9734,   9998,  -2076,    446,    -44 },
+  {    -47,    460,  -2085,   9599,  10130,  -2071,    441,    -43 },
+  {    -48,    464,  -2086,   9464,  10261,  -2064,    435,    -42 },
+  {    -49,    467,  -2085,   9328,  10390,  -2055,    428,    -40 },
+  {    -50,    470,  -2083,   9191,  10519,  -2046,    422,    -39 },
+  {    -51,    473,  -2080,   9054,  10645,  -2035,    415,    -37 },
+  {    -51,    475,  -2076,   8916,  10772,  -2023,    407,    -36 },
+  {    -52,    477,  -2071,   8777,  10897,  -2009,    399,    -34 },
+  {    -52,    479,  -2065,   8638,  11019,  -1994,    391,    -32 },
+  {    -52,    480,  -2057,   8498,  11140,  -1977,    382,    -30 },
+  {    -53,    481,  -2049,   8357,  11262,  -1959,    373,    -28 },
+  {    -53,    481,  -2039,   8216,  11381,  -1939,    363,    -26 },
+  {    -53,    482,  -2029,   8075,  11497,  -1918,    353,    -23 },
+  {    -53,    481,  -2017,   7934,  11614,  -1896,    342,    -21 },
+  {    -53,    481,  -2005,   7792,  11727,  -1871,    331,    -18 },
+  {    -53,    480,  -1992,   7650,  11842,  -1846,    319,    -16 },
+  {    -53,    479,  -1977,   7507,  11952,  -1818,    307,    -13 },
+  {    -53,    478,  -1962,   7365,  12061,  -1790,    295,    -10 },
+  {    -53,    476,  -1946,   7222,  12169,  -1759,    282,     -7 },
+  {    -52,    475,  -1930,   7079,  12275,  -1727,    268,     -4 },
+  {    -52,    472,  -1912,   6937,  12379,  -1694,    255,     -1 },
+  {    -52,    470,  -1894,   6794,  12482,  -1658,    240,      2 },
+  {    -51,    467,  -1875,   6651,  12582,  -1621,    225,      6 },
+  {    -51,    465,  -1855,   6509,  12680,  -1583,    210,      9 },
+  {    -51,    461,  -1834,   6366,  12778,  -1543,    194,     13 },
+  {    -50,    458,  -1813,   6224,  12872,  -1501,    178,     16 },
+  {    -50,    454,  -1791,   6082,  12965,  -1457,    161,     20 },
+  {    -49,    451,  -1769,   5940,  13055,  -1412,    144,     24 },
+  {    -48,    447,  -1746,   5799,  13142,  -1365,    127,     28 },
+  {    -48,    442,  -1722,   5658,  13229,  -1316,    109,     32 },
+  {    -47,    438,  -1698,   5517,  13313,  -1266,     90,     37 },
+  {    -46,    433,  -1673,   5377,  13395,  -1214,     71,     41 },
+  {    -46,    429,  -1648,   5237,  13475,  -1160,     52,     45 },
+  {    -45,    424,  -1622,   5098,  13552,  -1105,     32,     50 },
+  {    -44,    418,  -1596,   4960,  13627,  -1047,     11,     55 },
+  {    -43,    413,  -1569,   4822,  13698,   -988,     -9,     60 },
+  {    -42,    408,  -1542,   4685,  13768,   -928,    -30,     65 },
+  {    -42,    402,  -1515,   4548,  13838,   -865,    -52,     70 },
+  {    -41,    396,  -1487,   4412,  13904,   -801,    -74,     75 },
+  {    -40,    391,  -1459,   4277,  13967,   -735,    -97,     80 },
+  {    -39,    385,  -1431,   4143,  14027,   -667,   -119,     85 },
+  {    -38,    379,  -1402,   4009,  14086,   -598,   -143,     91 },
+  {    -37,    372,  -1373,   3877,  14142,   -527,   -166,     96 },
+  {    -36,    366,  -1344,   3745,  14195,   -454,   -190,    102 },
+  {    -35,    360,  -1314,   3614,  14247,   -380,   -215,    107 },
+  {    -35,    353,  -1285,   3485,  14296,   -303,   -240,    113 },
+  {    -34,    347,  -1255,   3356,  14341,   -225,   -265,    119 },
+  {    -33,    340,  -1225,   3228,  14385,   -146,   -290,    125 },
+  {    -32,    333,  -1195,   3102,  14425,    -64,   -316,    131 },
+  {    -31,    327,  -1164,   2976,  14463,     19,   -343,    137 },
+  {    -30,    320,  -1134,   2852,  14499,    103,   -369,    143 },
+  {    -29,    313,  -1103,   2729,  14530,    190,   -396,    150 },
+  {    -28,    306,  -1073,   2607,  14561,    278,   -423,    156 },
+  {    -27,    299,  -1042,   2486,  14589,    367,   -451,    163 },
+  {    -26,    292,  -1012,   2367,  14613,    459,   -478,    169 },
+  {    -25,    285,   -981,   2248,  14635,    552,   -506,    176 },
+  {    -24,    278,   -951,   2131,  14657,    646,   -535,    182 },
+  {    -24,    271,   -920,   2016,  14672,    743,   -563,    189 },
+  {    -23,    264,   -890,   1902,  14687,    840,   -592,    196 },
+  {    -22,    257,   -859,   1789,  14698,    940,   -621,    202 },
+  {    -21,    251,   -829,   1678,  14706,   1040,   -650,    209 },
+  {    -20,    244,   -799,   1568,  14711,   1143,   -679,    216 },
+  {    -19,    237,   -769,   1459,  14715,   1247,   -709,    223 },
+};
+
+// IMA-ADPCM quantizer steps and step index adaptation
+const int16_t adpcmSteps[AUDIO_ADPCM_STEPS] =
+{
+  7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37,
+  41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173,
+  190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658,
+  724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+  2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894,
+  6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289,
+  16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+};
+
+const int8_t adpcmIndexes[16] =
+{
+  -1, -1, -1, -1, 2, 4, 6, 8,
+  -1, -1, -1, -1, 2, 4, 6, 8,
+};
+
 #if defined(SDCARD)
 
 const char * const unitsFilenames[] = {
@@ -308,6 +461,10 @@ void referenceSystemAudioFiles()
     }
     f_closedir(&dir);
   }
+
+#if defined(PROMPT_CACHE_SIZE)
+  audioQueue.preloadPrompts();
+#endif
 }
 
 void referenceModelAudioFiles()
@@ -434,10 +591,15 @@ AudioQueue::AudioQueue()
   priorityContext(),
   varioContext(),
   fragmentsFifo()
+#if defined(PROMPT_CACHE_SIZE)
+  , preloadRequested(false),
+  preloadIndex(AU_SPECIAL_SOUND_FIRST)
+#endif
 {
 }
 
 #define CODEC_ID_PCM_S16LE  1
+#define CODEC_ID_IMA_ADPCM  0x11
 
 #if !defined(SIMU)
 void audioTask(void * pdata)
@@ -463,15 +625,203 @@ void audioTask(void * pdata)
 }
 #endif
 
-inline void mixSample(audio_data_t * result, int sample, unsigned int fade)
+void AudioResampler::reset(uint32_t freq)
+{
+  step = freq ? audioResamplerStep(freq) : 0;
+  pos = 0;
+  historyCount = 0;
+}
+
+uint32_t AudioResampler::input(uint32_t count) const
 {
-  *result = limit(AUDIO_DATA_MIN, *result + ((sample >> fade) >> (16-AUDIO_BITS_PER_SAMPLE)), AUDIO_DATA_MAX);
+  return audioResamplerInput(pos, step, count, historyCount);
+}
+
+audio_data_t * AudioResampler::mix(audio_data_t * dst, uint32_t count,
+                                   int16_t * src, uint32_t read, uint8_t shift)
+{
+  src -= historyCount;
+  memcpy(src, history, historyCount * sizeof(int16_t));
+
+  uint32_t available = historyCount + read;
+  dst = audioMixResampled(dst, count, src, available, pos, step, shift);
+
+  // keep the samples needed by the next call
+  uint32_t consumed = min<uint32_t>(pos >> AUDIO_RESAMPLER_POS_SHIFT, available);
+  historyCount = min<uint32_t>(available - consumed, AUDIO_RESAMPLER_TAPS);
+  memcpy(history, src + available - historyCount,
+         historyCount * sizeof(int16_t));
+  uint32_t first = (available - historyCount) << AUDIO_RESAMPLER_POS_SHIFT;
+  pos = pos > first ? pos - first : 0;
+
+  return dst;
+}
+
+void AdpcmDecoder::reset(uint16_t blockSize)
+{
+  predictor = 0;
+  index = 0;
+  this->blockSize = blockSize;
+  blockOffset = 0;
+}
+
+uint32_t AdpcmDecoder::decode(int16_t * dst, const uint8_t * src,
+                              uint32_t count)
+{
+  int16_t * start = dst;
+
+  for (uint32_t i = 0; i < count; i++) {
+    uint8_t value = src[i];
+    if (blockOffset < AUDIO_ADPCM_HEADER_SIZE) {
+      // block header: first sample (LE), step index, reserved
+      if (blockOffset == 0) {
+        predictor = value;
+      }
+      else if (blockOffset == 1) {
+        predictor = (int16_t)(predictor | (value << 8));
+      }
+      else if (blockOffset == 2) {
+        index = min<uint8_t>(value, AUDIO_ADPCM_STEPS - 1);
+      }
+      else {
+        *dst++ = predictor;
+      }
+    }
+    else {
+      *dst++ = audioAdpcmDecode(value & 0x0F, predictor, index);
+      *dst++ = audioAdpcmDecode(value >> 4, predictor, index);
+    }
+    if (++blockOffset >= blockSize) {
+      blockOffset = 0;
+    }
+  }
+
+  return dst - start;
 }
 
 #if defined(SDCARD)
 
 #define RIFF_CHUNK_SIZE 12
-uint8_t wavBuffer[AUDIO_BUFFER_SIZE*2] __DMA;
+
+// room for the resampler history, then the samples read from the file
+// (the extra taps being slack for the ADPCM decoding done in place)
+#define WAV_BUFFER_SAMPLES (AUDIO_RESAMPLER_TAPS * 3 + \
+                            AUDIO_BUFFER_SIZE * AUDIO_RESAMPLER_MAX_RATE / AUDIO_SAMPLE_RATE)
+uint8_t wavBuffer[WAV_BUFFER_SAMPLES*2] __DMA;
+
+#if defined(PROMPT_CACHE_SIZE)
+uint8_t promptCachePool[PROMPT_CACHE_SIZE] __SDRAM;
+PromptCache promptCache;
+#endif
+
+// Parses the header of a WAV file, the file being left at the start
+// of the samples
+static FRESULT openWavFile(FIL * file, const char * filename,
+                           PromptFormat & format)
+{
+  UINT read;
+  FRESULT result = f_open(file, filename, FA_OPEN_EXISTING | FA_READ);
+  if (result != FR_OK) {
+    return result;
+  }
+
+  result = f_read(file, wavBuffer, RIFF_CHUNK_SIZE+8, &read);
+  if (result == FR_OK && read == RIFF_CHUNK_SIZE+8 && !memcmp(wavBuffer, "RIFF", 4) && !memcmp(wavBuffer+8, "WAVEfmt ", 8)) {
+    uint32_t size = *((uint32_t *)(wavBuffer+16));
+    result = (size < 256 ? f_read(file, wavBuffer, size+8, &read) : FR_DENIED);
+    if (result == FR_OK && read == size+8) {
+      uint16_t channels = ((uint16_t *)wavBuffer)[1];
+      format.codec = ((uint16_t *)wavBuffer)[0];
+      format.freq = ((uint16_t *)wavBuffer)[2];
+      format.blockSize = ((uint16_t *)wavBuffer)[6];
+      if (format.codec == CODEC_ID_IMA_ADPCM && (channels != 1 || format.blockSize <= AUDIO_ADPCM_HEADER_SIZE)) {
+        // ADPCM: mono only, a block holding at least one code
+        result = FR_DENIED;
+      }
+      uint32_t *wavSamplesPtr = (uint32_t *)(wavBuffer + size);
+      size = wavSamplesPtr[1];
+      while (result == FR_OK && memcmp(wavSamplesPtr, "data", 4) != 0) {
+        result = f_lseek(file, f_tell(file)+size);
+        if (result == FR_OK) {
+          result = f_read(file, wavBuffer, 8, &read);
+          if (read != 8) result = FR_DENIED;
+          wavSamplesPtr = (uint32_t *)wavBuffer;
+          size = wavSamplesPtr[1];
+        }
+      }
+      format.size = size;
+    }
+    else {
+      result = FR_DENIED;
+    }
+  }
+  else {
+    result = FR_DENIED;
+  }
+
+  if (result != FR_OK) {
+    f_close(file);
+  }
+  return result;
+}
+
+FRESULT WavContext::setFormat(const PromptFormat & format)
+{
+  state.codec = format.codec;
+  state.freq = format.freq;
+  state.size = format.size;
+  state.resampler.reset(0);
+  state.adpcm.reset(format.blockSize);
+
+  bool decoded = (state.codec == CODEC_ID_PCM_S16LE || state.codec == CODEC_ID_IMA_ADPCM);
+  if (state.freq == AUDIO_SAMPLE_RATE) {
+    state.readSize = (decoded ? 2*AUDIO_BUFFER_SIZE : AUDIO_BUFFER_SIZE);
+  }
+  else if (decoded && state.freq >= AUDIO_RESAMPLER_MIN_RATE && state.freq <= AUDIO_RESAMPLER_MAX_RATE) {
+    state.resampler.reset(state.freq);
+  }
+  else {
+    return FR_DENIED;
+  }
+  return FR_OK;
+}
+
+FRESULT WavContext::readSamples(uint8_t * data, UINT size, UINT * read)
+{
+#if defined(PROMPT_CACHE_SIZE)
+  if (state.cached.valid()) {
+    uint32_t offset = promptCache.getFormat(state.cached).size - state.size;
+    *read = promptCache.read(state.cached, offset, data, size);
+    return FR_OK;
+  }
+#endif
+
+  FRESULT result = f_read(&state.file, data, size, read);
+
+#if defined(PROMPT_CACHE_SIZE)
+  if (state.capture.valid()) {
+    if (result == FR_OK)
+      promptCache.append(state.capture, data, *read);
+    else
+      promptCache.abort(state.capture);
+  }
+#endif
+
+  return result;
+}
+
+void WavContext::closeFile()
+{
+#if defined(PROMPT_CACHE_SIZE)
+  // the file was shorter than its header
+  promptCache.abort(state.capture);
+  if (state.cached.valid()) {
+    state.cached.index = PROMPT_CACHE_NONE;
+    return;
+  }
+#endif
+  f_close(&state.file);
+}
 
 int WavContext::mixBuffer(AudioBuffer *buffer, int volume, unsigned int fade)
 {
@@ -482,67 +832,74 @@ int WavContext::mixBuffer(AudioBuffer *buffer, int volume, unsigned int fade)
     volume = fragment.fragmentVolume;
 
   if (fragment.file[1]) {
-    result = f_open(&state.file, fragment.file, FA_OPEN_EXISTING | FA_READ);
-    fragment.file[1] = 0;
+    PromptFormat format;
+#if defined(PROMPT_CACHE_SIZE)
+    state.capture.index = PROMPT_CACHE_NONE;
+    state.cached = promptCache.find(fragment.file);
+    if (state.cached.valid()) {
+      format = promptCache.getFormat(state.cached);
+    }
+    else
+#endif
+    {
+      result = openWavFile(&state.file, fragment.file, format);
+    }
     if (result == FR_OK) {
-      result = f_read(&state.file, wavBuffer, RIFF_CHUNK_SIZE+8, &read);
-      if (result == FR_OK && read == RIFF_CHUNK_SIZE+8 && !memcmp(wavBuffer, "RIFF", 4) && !memcmp(wavBuffer+8, "WAVEfmt ", 8)) {
-        uint32_t size = *((uint32_t *)(wavBuffer+16));
-        result = (size < 256 ? f_read(&state.file, wavBuffer, size+8, &read) : FR_DENIED);
-        if (result == FR_OK && read == size+8) {
-          state.codec = ((uint16_t *)wavBuffer)[0];
-          state.freq = ((uint16_t *)wavBuffer)[2];
-          uint32_t *wavSamplesPtr = (uint32_t *)(wavBuffer + size);
-          uint32_t size = wavSamplesPtr[1];
-          if (state.freq != 0 && state.freq * (AUDIO_SAMPLE_RATE / state.freq) == AUDIO_SAMPLE_RATE) {
-            state.resampleRatio = (AUDIO_SAMPLE_RATE / state.freq);
-            state.readSize = (state.codec == CODEC_ID_PCM_S16LE ? 2*AUDIO_BUFFER_SIZE : AUDIO_BUFFER_SIZE) / state.resampleRatio;
-          }
-          else {
-            result = FR_DENIED;
-          }
-          while (result == FR_OK && memcmp(wavSamplesPtr, "data", 4) != 0) {
-            result = f_lseek(&state.file, f_tell(&state.file)+size);
-            if (result == FR_OK) {
-              result = f_read(&state.file, wavBuffer, 8, &read);
-              if (read != 8) result = FR_DENIED;
-              wavSamplesPtr = (uint32_t *)wavBuffer;
-              size = wavSamplesPtr[1];
-            }
-          }
-          state.size = size;
-        }
-        else {
-          result = FR_DENIED;
-        }
-      }
-      else {
-        result = FR_DENIED;
+      result = setFormat(format);
+#if defined(PROMPT_CACHE_SIZE)
+      if (result == FR_OK && !state.cached.valid()) {
+        state.capture = promptCache.create(fragment.file, format);
       }
+#endif
     }
+    fragment.file[1] = 0;
   }
 
   if (result == FR_OK) {
+    // the file is read at an aligned address, leaving room
+    // for the samples kept by the resampler
+    int16_t * pcm = (int16_t *)wavBuffer + AUDIO_RESAMPLER_TAPS;
+    UINT readSize = state.readSize;
+    if (state.resampler.active()) {
+      readSize = 2 * state.resampler.input(AUDIO_BUFFER_SIZE);
+    }
+
+    // ADPCM: 2 samples per byte at most, the codes are read at the end
+    // of the buffer (aligned), then decoded in place from the start
+    uint8_t * data = (uint8_t *)pcm;
+    if (state.codec == CODEC_ID_IMA_ADPCM) {
+      readSize /= 4;
+      data = (uint8_t *)((uintptr_t)(wavBuffer + sizeof(wavBuffer) - readSize) & ~3);
+    }
+
     read = 0;
-    result = f_read(&state.file, wavBuffer, state.readSize, &read);
+    result = readSamples(data, readSize, &read);
     if (result == FR_OK) {
       if (read > state.size) {
         read = state.size;
       }
       state.size -= read;
 
-      if (read != state.readSize) {
-        f_close(&state.file);
+      if (read != readSize) {
+        closeFile();
         fragment.clear();
       }
 
       audio_data_t * samples = buffer->data;
-      if (state.codec == CODEC_ID_PCM_S16LE) {
-        read /= 2;
-        for (uint32_t i=0; i<read; i++) {
-          for (uint8_t j=0; j<state.resampleRatio; j++) {
-            mixSample(samples++, ((int16_t *)wavBuffer)[i], fade+2-volume);
-          }
+      if (state.codec == CODEC_ID_PCM_S16LE || state.codec == CODEC_ID_IMA_ADPCM) {
+        uint8_t shift = fade + 2 - volume + 16 - AUDIO_BITS_PER_SAMPLE;
+        if (state.codec == CODEC_ID_IMA_ADPCM) {
+          read = state.adpcm.decode(pcm, data, read);
+        }
+        else {
+          read /= 2;
+        }
+        if (state.resampler.active()) {
+          samples = state.resampler.mix(samples, AUDIO_BUFFER_SIZE, pcm, read,
+                                        shift);
+        }
+        else {
+          samples = audioMixSamples(samples, pcm, read, shift);
         }
       }
 
@@ -555,6 +912,37 @@ int WavContext::mixBuffer(AudioBuffer *buffer, int volume, unsigned int fade)
   }
   return 0;
 }
+
+#if defined(PROMPT_CACHE_SIZE)
+// Loads the next available system sound in the prompt cache
+void AudioQueue::preloadPrompt()
+{
+  while (preloadIndex < AU_SPECIAL_SOUND_FIRST) {
+    uint8_t index = preloadIndex++;
+    if (!sdAvailableSystemAudioFiles.getBit(index)) {
+      continue;
+    }
+
+    char filename[AUDIO_FILENAME_MAXLEN+1];
+    PromptFormat format;
+    FIL file;
+    getSystemAudioFile(filename, index);
+    if (openWavFile(&file, filename, format) == FR_OK) {
+      PromptCacheHandle handle = promptCache.create(filename, format);
+      while (handle.valid()) {
+        UINT read = 0;
+        if (f_read(&file, wavBuffer, sizeof(wavBuffer), &read) != FR_OK || read == 0) {
+          promptCache.abort(handle);
+          break;
+        }
+        promptCache.append(handle, wavBuffer, read);
+      }
+      f_close(&file);
+    }
+    break;
+  }
+}
+#endif
 #else
 int WavContext::mixBuffer(AudioBuffer *buffer, int volume, unsigned int fade)
 {
@@ -563,13 +951,20 @@ int WavContext::mixBuffer(AudioBuffer *buffer, int volume, unsigned int fade)
 #endif
 
 const uint8_t toneVolumes[] = { 10, 8, 6, 4, 2 };
-inline float evalVolumeRatio(int freq, int volume)
+inline int32_t evalToneGain(int freq, int volume)
 {
-  float result = toneVolumes[2+volume];
+  int32_t ratio = toneVolumes[2+volume];
+  if (freq == 0) {
+    return 0;
+  }
+  // the tone isn't played lower, see the step limit in mixBuffer()
+  if (freq < AUDIO_TONE_MIN_FREQ) {
+    freq = AUDIO_TONE_MIN_FREQ;
+  }
   if (freq < 330) {
-    result = (result * freq * freq) / (330 * 330);
+    return ((int64_t)AUDIO_GAIN_UNITY * 330 * 330) / (ratio * freq * freq);
   }
-  return result;
+  return AUDIO_GAIN_UNITY / ratio;
 }
 
 int ToneContext::mixBuffer(AudioBuffer * buffer, int volume, unsigned int fade)
@@ -583,7 +978,7 @@ int ToneContext::mixBuffer(AudioBuffer * buffer, int volume, unsigned int fade)
   int remainingDuration = fragment.tone.duration - state.duration;
   if (remainingDuration > 0) {
     int points;
-    float toneIdx = state.idx;
+    uint32_t phase = state.phase;
 
     if (fragment.tone.reset) {
       fragment.tone.reset = 0;
@@ -593,8 +988,10 @@ int ToneContext::mixBuffer(AudioBuffer * buffer, int volume, unsigned int fade)
 
     if (fragment.tone.freq != state.freq) {
       state.freq = fragment.tone.freq;
-      state.step = limit<float>(1, float(fragment.tone.freq) * (float(DIM(sineValues))/float(AUDIO_SAMPLE_RATE)), 512);
-      state.volume = 1.0f / evalVolumeRatio(fragment.tone.freq, volume);
+      state.step = limit<uint32_t>(1 << AUDIO_PHASE_SHIFT,
+                                   audioPhaseStep(fragment.tone.freq),
+                                   (AUDIO_SINE_SIZE / 2) << AUDIO_PHASE_SHIFT);
+      state.gain = evalToneGain(fragment.tone.freq, volume);
     }
 
     if (fragment.tone.freqIncr) {
@@ -622,25 +1019,21 @@ int ToneContext::mixBuffer(AudioBuffer * buffer, int volume, unsigned int fade)
     else {
       duration = remainingDuration;
       points = (duration * AUDIO_BUFFER_SIZE) / AUDIO_BUFFER_DURATION;
-      unsigned int end = toneIdx + (state.step * points);
-      if (end > DIM(sineValues))
-        end -= (end % DIM(sineValues));
+      // the tone ends with a full period of the sine
+      uint64_t end = phase + (uint64_t)state.step * points;
+      if (end > (1ull << 32))
+        end &= ~0xFFFFFFFFull;
       else
-        end = DIM(sineValues);
-      points = (float(end) - toneIdx) / state.step;
+        end = 1ull << 32;
+      points = min<int>((end - phase) / state.step, AUDIO_BUFFER_SIZE);
     }
 
-    for (int i=0; i<points; i++) {
-      int16_t sample = sineValues[int(toneIdx)] * state.volume;
-      mixSample(&buffer->data[i], sample, fade);
-      toneIdx += state.step;
-      if ((unsigned int)toneIdx >= DIM(sineValues))
-        toneIdx -= DIM(sineValues);
-    }
+    phase = audioMixTone(buffer->data, points, phase, state.step, state.gain,
+                         fade + 16 - AUDIO_BITS_PER_SAMPLE);
 
     if (remainingDuration > AUDIO_BUFFER_DURATION) {
       state.duration += AUDIO_BUFFER_DURATION;
-      state.idx = toneIdx;
+      state.phase = phase;
       return AUDIO_BUFFER_SIZE;
     }
     else {
@@ -662,6 +1055,15 @@ int ToneContext::mixBuffer(AudioBuffer * buffer, int volume, unsigned int fade)
 
 void AudioQueue::wakeup()
 {
+#if defined(PROMPT_CACHE_SIZE)
+  if (preloadRequested) {
+    // the system sounds have changed (SD card, language)
+    preloadRequested = false;
+    promptCache.initialize(promptCachePool, sizeof(promptCachePool));
+    preloadIndex = 0;
+  }
+#endif
+
   DEBUG_TIMER_START(debugTimerAudioConsume);
   audioConsumeCurrentBuffer();
   DEBUG_TIMER_STOP(debugTimerAudioConsume);
@@ -718,10 +1120,8 @@ void AudioQueue::wakeup()
 
 #if defined(SOFTWARE_VOLUME)
       if (currentSpeakerVolume > 0) {
-        for (uint32_t i=0; i<buffer->size; ++i) {
-          int32_t tmpSample = (int32_t) ((uint32_t) (buffer->data[i]) - AUDIO_DATA_SILENCE);  // conversion from uint16_t
-          buffer->data[i] = (int16_t) (((tmpSample * currentSpeakerVolume) / VOLUME_LEVEL_MAX) + AUDIO_DATA_SILENCE);
-        }
+        audioScaleSamples(buffer->data, buffer->size,
+                          (currentSpeakerVolume << 15) / VOLUME_LEVEL_MAX);
         buffersFifo.audioPushBuffer();
       }
       else {
@@ -739,6 +1139,15 @@ void AudioQueue::wakeup()
     audioConsumeCurrentBuffer();
     DEBUG_TIMER_STOP(debugTimerAudioConsume);
   }
+
+#if defined(PROMPT_CACHE_SIZE)
+  // the SD card is only read for the cache when nothing is played
+  if (preloadIndex < AU_SPECIAL_SOUND_FIRST && normalContext.isEmpty() &&
+      fragmentsFifo.empty() && priorityContext.isFree() &&
+      varioContext.isFree() && !isFunctionActive(FUNCTION_BACKGND_MUSIC)) {
+    preloadPrompt();
+  }
+#endif
 }
 
 inline unsigned int getToneLength(uint16_t len)
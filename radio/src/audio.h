@@ -27,6 +27,7 @@
 #include "ff.h"
 #include "opentx_types.h"
 #include "dataconstants.h"
+#include "prompt_cache.h"
 
 /*
   Implements a bit field, number of bits is set by the template,
@@ -78,6 +79,7 @@ constexpr uint8_t AUDIO_FILENAME_MAXLEN = (AUDIO_LUA_FILENAME_MAXLEN > AUDIO_MOD
 #define AUDIO_SAMPLE_RATE              (32000)
 #define AUDIO_BUFFER_DURATION          (10)
 #define AUDIO_BUFFER_SIZE              (AUDIO_SAMPLE_RATE*AUDIO_BUFFER_DURATION/1000)
+#define AUDIO_RESAMPLER_TAPS           (8)
 
 #if defined(SIMU) && defined(SIMU_AUDIO)
   #define AUDIO_BUFFER_COUNT           (10) // simulator needs more buffers for smooth audio
@@ -89,6 +91,11 @@ constexpr uint8_t AUDIO_FILENAME_MAXLEN = (AUDIO_LUA_FILENAME_MAXLEN > AUDIO_MOD
   #define AUDIO_BUFFER_COUNT           (3)
 #endif
 
+// short prompts kept in RAM, see PromptCache
+#if defined(SDRAM)
+  #define PROMPT_CACHE_SIZE            (512 * 1024)
+#endif
+
 #define BEEP_MIN_FREQ                  (150)
 #define BEEP_MAX_FREQ                  (15000)
 #define BEEP_DEFAULT_FREQ              (2250)
@@ -219,9 +226,9 @@ class ToneContext {
     AudioFragment fragment;
 
     struct {
-      float step;
-      float idx;
-      float  volume;
+      uint32_t step;    // phase increment per sample
+      uint32_t phase;   // 2^32 = one period of the sine table
+      int32_t gain;     // fixed-point volume (AUDIO_GAIN_SHIFT)
       uint16_t freq;
       uint16_t duration;
       uint16_t pause;
@@ -229,6 +236,50 @@ class ToneContext {
 
 };
 
+// Streaming resampler of the WAV files to AUDIO_SAMPLE_RATE
+class AudioResampler {
+  public:
+    // 'freq' = 0 when no resampling is needed
+    void reset(uint32_t freq);
+
+    bool active() const
+    {
+      return step != 0;
+    }
+
+    // Number of source samples needed for the next 'count' samples
+    uint32_t input(uint32_t count) const;
+
+    // Mixes up to 'count' samples resampled from the 'read' source
+    // samples at 'src', the AUDIO_RESAMPLER_TAPS samples before 'src'
+    // being used for the ones kept from the previous call
+    audio_data_t * mix(audio_data_t * dst, uint32_t count, int16_t * src,
+                       uint32_t read, uint8_t shift);
+
+  private:
+    uint32_t step;          // 16.16 source samples per output sample
+    uint32_t pos;           // 16.16 position in the source samples
+    uint8_t  historyCount;
+    int16_t  history[AUDIO_RESAMPLER_TAPS];
+};
+
+// Streaming IMA-ADPCM decoder (mono WAV files): the bytes may be
+// given in chunks of any size, the block headers being parsed on
+// the fly
+class AdpcmDecoder {
+  public:
+    void reset(uint16_t blockSize);
+
+    // Decodes 'count' bytes, returns the number of samples
+    uint32_t decode(int16_t * dst, const uint8_t * src, uint32_t count);
+
+  private:
+    int32_t  predictor;
+    uint16_t blockSize;     // bytes per block, header included
+    uint16_t blockOffset;
+    uint8_t  index;
+};
+
 class WavContext {
   public:
 
@@ -257,9 +308,18 @@ class WavContext {
       uint8_t  codec;
       uint32_t freq;
       uint32_t size;
-      uint8_t  resampleRatio;
       uint16_t readSize;
+      AudioResampler resampler;
+      AdpcmDecoder adpcm;
+#if defined(PROMPT_CACHE_SIZE)
+      PromptCacheHandle cached;   // played from the cache
+      PromptCacheHandle capture;  // being added to the cache
+#endif
     } state;
+
+    FRESULT setFormat(const PromptFormat & format);
+    FRESULT readSamples(uint8_t * data, UINT size, UINT * read);
+    void closeFile();
 };
 
 class MixedContext {
@@ -527,6 +587,10 @@ class AudioQueue {
     bool isEmpty() const { return fragmentsFifo.empty(); };
     void wakeup();
     bool started() const { return _started; };
+#if defined(PROMPT_CACHE_SIZE)
+    // Reloads the system sounds in the prompt cache
+    void preloadPrompts() { preloadRequested = true; }
+#endif
 #if defined(AUDIO_UNMUTE_DELAY)
     tmr10ms_t lastAudioPlayTime = 0;
 #endif
@@ -540,6 +604,12 @@ class AudioQueue {
     ToneContext  priorityContext;
     ToneContext  varioContext;
     AudioFragmentFifo fragmentsFifo;
+#if defined(PROMPT_CACHE_SIZE)
+    volatile bool preloadRequested;
+    uint8_t preloadIndex;
+
+    void preloadPrompt();
+#endif
 };
 
 extern uint8_t currentSpeakerVolume;
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+// Fixed-point mixing kernels used by the audio contexts.
+//
+// On the radios, the saturation uses the SSAT / USAT instructions
+// (CMSIS), and the 16-bit signed DACs mix 2 samples at a time with
+// QADD16 when the DSP extension is available. The portable versions
+// are used by the simulator and the host tests.
+
+#include "audio.h"
+
+// Tones are generated by a 32-bit phase accumulator (NCO):
+// a full period of the sine table is 2^32
+#define AUDIO_SINE_BITS                10
+#define AUDIO_SINE_SIZE                (1 << AUDIO_SINE_BITS)
+#define AUDIO_PHASE_SHIFT              (32 - AUDIO_SINE_BITS)
+
+// Lowest tone frequency: one sine table entry per sample
+#define AUDIO_TONE_MIN_FREQ            (AUDIO_SAMPLE_RATE >> AUDIO_SINE_BITS)
+
+// Tone volumes are 20.12 fixed-point gains, limited so that
+// their product with a sine value fits in 32 bits
+#define AUDIO_GAIN_SHIFT               12
+#define AUDIO_GAIN_UNITY               (1 << AUDIO_GAIN_SHIFT)
+#define AUDIO_GAIN_MAX                 (INT32_MAX / INT16_MAX)
+
+extern const int16_t sineValues[AUDIO_SINE_SIZE];
+
+// WAV files at other rates than AUDIO_SAMPLE_RATE are resampled by
+// a polyphase FIR filter: the position in the source samples is a
+// 16.16 fixed-point value, its fractional part selects the taps
+#define AUDIO_RESAMPLER_MIN_RATE       8000
+#define AUDIO_RESAMPLER_MAX_RATE       48000
+#define AUDIO_RESAMPLER_PHASE_BITS     7
+#define AUDIO_RESAMPLER_PHASES         (1 << AUDIO_RESAMPLER_PHASE_BITS)
+#define AUDIO_RESAMPLER_TAPS_SHIFT     14
+#define AUDIO_RESAMPLER_POS_SHIFT      16
+
+extern const int16_t resamplerTaps[AUDIO_RESAMPLER_PHASES][AUDIO_RESAMPLER_TAPS];
+
+inline uint32_t audioPhaseStep(uint32_t freq)
+{
+  return (uint32_t)(((uint64_t)freq << 32) / AUDIO_SAMPLE_RATE);
+}
+
+// Clamps a mixed sample to the DAC range
+inline audio_data_t audioSaturate(int32_t value)
+{
+#if defined(__SSAT) && AUDIO_DATA_MIN < 0
+  return __SSAT(value, AUDIO_BITS_PER_SAMPLE);
+#elif defined(__USAT) && AUDIO_DATA_MIN == 0
+  return __USAT(value, AUDIO_BITS_PER_SAMPLE);
+#else
+  return value < AUDIO_DATA_MIN ? AUDIO_DATA_MIN
+       : (value > AUDIO_DATA_MAX ? AUDIO_DATA_MAX : value);
+#endif
+}
+
+// Mixes 16-bit PCM samples, 'shift' including the fade and the DAC resolution
+inline audio_data_t* audioMixSamples(audio_data_t* dst, const int16_t* src,
+                                     uint32_t count, uint8_t shift)
+{
+#if defined(__ARM_FEATURE_DSP) && AUDIO_DATA_MIN < 0 && \
+    AUDIO_BITS_PER_SAMPLE == 16
+  uint32_t pairs = count / 2;
+  for (uint32_t i = 0; i < pairs; i++) {
+    uint32_t mixed, samples;
+    memcpy(&mixed, dst, sizeof(mixed));
+    samples = __PKHBT(src[0] >> shift, src[1] >> shift, 16);
+    mixed = __QADD16(mixed, samples);
+    memcpy(dst, &mixed, sizeof(mixed));
+    dst += 2;
+    src += 2;
+  }
+  count -= pairs * 2;
+#endif
+  for (uint32_t i = 0; i < count; i++) {
+    *dst = audioSaturate(*dst + (src[i] >> shift));
+    dst++;
+  }
+  return dst;
+}
+
+inline uint32_t audioResamplerStep(uint32_t freq)
+{
+  return (freq << AUDIO_RESAMPLER_POS_SHIFT) / AUDIO_SAMPLE_RATE;
+}
+
+// Number of source samples to add to the 'available' ones,
+// so that 'count' samples can be produced from position 'pos'
+inline uint32_t audioResamplerInput(uint32_t pos, uint32_t step,
+                                    uint32_t count, uint32_t available)
+{
+  uint32_t needed = ((pos + (count - 1) * step) >> AUDIO_RESAMPLER_POS_SHIFT) +
+                    AUDIO_RESAMPLER_TAPS;
+  return needed > available ? needed - available : 0;
+}
+
+// Mixes up to 'count' samples resampled from the 'available' source
+// samples, stops when the source is exhausted. 'pos' is updated.
+inline audio_data_t* audioMixResampled(audio_data_t* dst, uint32_t count,
+                                       const int16_t* src, uint32_t available,
+                                       uint32_t& pos, uint32_t step,
+                                       uint8_t shift)
+{
+  shift += AUDIO_RESAMPLER_TAPS_SHIFT;
+  for (; count > 0; count--) {
+    // rounded to the nearest phase
+    uint32_t rounded = pos + (1 << (AUDIO_RESAMPLER_POS_SHIFT -
+                                    AUDIO_RESAMPLER_PHASE_BITS - 1));
+    uint32_t index = rounded >> AUDIO_RESAMPLER_POS_SHIFT;
+    if (index + AUDIO_RESAMPLER_TAPS > available) break;
+
+    const int16_t* in = src + index;
+    const int16_t* taps = resamplerTaps[(rounded >> (AUDIO_RESAMPLER_POS_SHIFT -
+                                                     AUDIO_RESAMPLER_PHASE_BITS)) &
+                                        (AUDIO_RESAMPLER_PHASES - 1)];
+    int32_t acc = 0;
+#if defined(__ARM_FEATURE_DSP)
+    for (uint8_t i = 0; i < AUDIO_RESAMPLER_TAPS; i += 2) {
+      uint32_t samples, coeffs;
+      memcpy(&samples, in + i, sizeof(samples));
+      memcpy(&coeffs, taps + i, sizeof(coeffs));
+      acc = __SMLAD(samples, coeffs, acc);
+    }
+#else
+    for (uint8_t i = 0; i < AUDIO_RESAMPLER_TAPS; i++) {
+      acc += in[i] * taps[i];
+    }
+#endif
+    *dst = audioSaturate(*dst + (acc >> shift));
+    dst++;
+    pos += step;
+  }
+  return dst;
+}
+
+// IMA-ADPCM: 4-bit codes, the quantizer step adapting to the signal
+#define AUDIO_ADPCM_STEPS              89
+#define AUDIO_ADPCM_HEADER_SIZE        4
+
+extern const int16_t adpcmSteps[AUDIO_ADPCM_STEPS];
+extern const int8_t adpcmIndexes[16];
+
+// Decodes one 4-bit code, updating the predictor and the step index
+inline int16_t audioAdpcmDecode(uint8_t code, int32_t& predictor,
+                                uint8_t& index)
+{
+  int32_t step = adpcmSteps[index];
+  int32_t diff = step >> 3;
+  if (code & 4) diff += step;
+  if (code & 2) diff += step >> 1;
+  if (code & 1) diff += step >> 2;
+  predictor += (code & 8) ? -diff : diff;
+  if (predictor > INT16_MAX) predictor = INT16_MAX;
+  else if (predictor < INT16_MIN) predictor = INT16_MIN;
+  int32_t next = index + adpcmIndexes[code];
+  index = next < 0 ? 0 : (next >= AUDIO_ADPCM_STEPS ? AUDIO_ADPCM_STEPS - 1 : next);
+  return predictor;
+}
+
+// Mixes 'count' samples of a tone, returns the new phase
+inline uint32_t audioMixTone(audio_data_t* dst, uint32_t count, uint32_t phase,
+                             uint32_t step, int32_t gain, uint8_t shift)
+{
+  // louder tones are clipped by audioSaturate()
+  if (gain > AUDIO_GAIN_MAX) gain = AUDIO_GAIN_MAX;
+  shift += AUDIO_GAIN_SHIFT;
+  for (uint32_t i = 0; i < count; i++) {
+    int32_t sample = (sineValues[phase >> AUDIO_PHASE_SHIFT] * gain) >> shift;
+    dst[i] = audioSaturate(dst[i] + sample);
+    phase += step;
+  }
+  return phase;
+}
+
+// Scales the samples around the silence level, 'volume' being
+// a 1.15 fixed-point ratio
+inline void audioScaleSamples(audio_data_t* data, uint32_t count,
+                              int32_t volume)
+{
+  for (uint32_t i = 0; i < count; i++) {
+    int32_t sample = (int32_t)data[i] - AUDIO_DATA_SILENCE;
+    data[i] = ((sample * volume) >> 15) + AUDIO_DATA_SILENCE;
+  }
+}
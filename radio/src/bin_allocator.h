@@ -24,6 +24,14 @@
 
 #include "debug.h"
 
+struct BinAllocatorStats {
+  uint32_t hits;        // allocations served by the bins
+  uint32_t misses;      // allocations which did fit, but all bins were used
+  uint16_t highWater;   // maximum number of bins used at once
+};
+
+// Fixed size bins, the free ones being chained through their data,
+// so that both malloc() and free() are O(1)
 template <int SIZE_SLOT, int NUM_BINS> class BinAllocator {
 private:
   PACK(struct Bin {
@@ -31,21 +39,49 @@ private:
     bool Used;
   });
   struct Bin Bins[NUM_BINS];
+  struct Bin * FreeBins;
   int NoUsedBins;
+  BinAllocatorStats Stats;
+
+  static_assert(SIZE_SLOT >= sizeof(struct Bin *), "Bin too small for the free list");
+
+  static struct Bin * getNextFree(struct Bin * bin) {
+    struct Bin * next;
+    memcpy(&next, bin->data, sizeof(next));
+    return next;
+  }
+  static void setNextFree(struct Bin * bin, struct Bin * next) {
+    memcpy(bin->data, &next, sizeof(next));
+  }
+  struct Bin * getBin(void * ptr) {
+    if (!is_member(ptr)) return nullptr;
+    size_t offset = (char *)ptr - Bins[0].data;
+    if (offset % sizeof(struct Bin)) return nullptr;
+    return &Bins[offset / sizeof(struct Bin)];
+  }
 public:
   BinAllocator() : NoUsedBins(0) {
     memclear(Bins, sizeof(Bins));
+    memclear(&Stats, sizeof(Stats));
+    FreeBins = nullptr;
+    for (int n = NUM_BINS - 1; n >= 0; --n) {
+      setNextFree(&Bins[n], FreeBins);
+      FreeBins = &Bins[n];
+    }
   }
   bool free(void * ptr) {
-    for (size_t n = 0; n < NUM_BINS; ++n) {
-      if (ptr == Bins[n].data) {
-        Bins[n].Used = false;
-        --NoUsedBins;
-        // TRACE("\tBinAllocator<%d> free %lu ------", SIZE_SLOT, n);
-        return true;
-      }
+    struct Bin * bin = getBin(ptr);
+    if (!bin) {
+      return false;
+    }
+    if (bin->Used) {
+      bin->Used = false;
+      setNextFree(bin, FreeBins);
+      FreeBins = bin;
+      --NoUsedBins;
+      // TRACE("\tBinAllocator<%d> free %lu ------", SIZE_SLOT, bin - Bins);
     }
-    return false;
+    return true;
   }
   bool is_member(void * ptr) {
     return (ptr >= Bins[0].data && ptr <= Bins[NUM_BINS-1].data);
@@ -55,20 +91,20 @@ public:
       // TRACE("BinAllocator<%d> malloc [%lu] size > SIZE_SLOT", SIZE_SLOT, size);
       return 0;
     }
-    if (NoUsedBins >= NUM_BINS) {
+    struct Bin * bin = FreeBins;
+    if (!bin) {
       // TRACE("BinAllocator<%d> malloc [%lu] no free slots", SIZE_SLOT, size);
+      ++Stats.misses;
       return 0;
     }
-    for (size_t n = 0; n < NUM_BINS; ++n) {
-      if (!Bins[n].Used) {
-        Bins[n].Used = true;
-        ++NoUsedBins;
-        // TRACE("\tBinAllocator<%d> malloc %lu[%lu]", SIZE_SLOT, n, size);
-        return Bins[n].data;
-      }
+    FreeBins = getNextFree(bin);
+    bin->Used = true;
+    if (++NoUsedBins > Stats.highWater) {
+      Stats.highWater = NoUsedBins;
     }
-    // TRACE("BinAllocator<%d> malloc [%lu] no free slots", SIZE_SLOT , size);
-    return 0;
+    ++Stats.hits;
+    // TRACE("\tBinAllocator<%d> malloc %lu[%lu]", SIZE_SLOT, bin - Bins, size);
+    return bin->data;
   }
   size_t size(void * ptr) {
     return is_member(ptr) ? SIZE_SLOT : 0;
@@ -78,6 +114,8 @@ public:
   }
   unsigned int capacity() { return NUM_BINS; }
   unsigned int size() { return NoUsedBins; }
+  unsigned int slotSize() { return SIZE_SLOT; }
+  const BinAllocatorStats & stats() { return Stats; }
 };
 
 #if defined(SIMU)
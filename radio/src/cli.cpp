@@ -40,6 +40,7 @@
 #include "tasks/mixer_task.h"
 
 #include "cli.h"
+#include "bin_allocator.h"
 
 #include <ctype.h>
 #include <malloc.h>
@@ -867,6 +868,18 @@ extern int _heap_start;
 extern int _heap_end;
 extern unsigned char *heap;
 
+#if defined(USE_BIN_ALLOCATOR)
+template <class T>
+static void cliPrintBinAllocator(T & allocator)
+{
+  const BinAllocatorStats & stats = allocator.stats();
+  cliSerialPrint("\t%3u bytes: used %u/%u, max %u, hits %u, misses %u",
+                 allocator.slotSize(), allocator.size(), allocator.capacity(),
+                 (unsigned)stats.highWater, (unsigned)stats.hits,
+                 (unsigned)stats.misses);
+}
+#endif
+
 int cliMemoryInfo(const char ** argv)
 {
   // struct mallinfo {
@@ -908,6 +921,12 @@ int cliMemoryInfo(const char ** argv)
   cliSerialPrint("------------");
   cliSerialPrint("\tTotal   %u", s + w + e);
 #endif
+#endif
+
+#if defined(USE_BIN_ALLOCATOR)
+  cliSerialPrint("\nBins:");
+  cliPrintBinAllocator(slots1);
+  cliPrintBinAllocator(slots2);
 #endif
   return 0;
 }
@@ -1270,6 +1289,14 @@ void printAudioVars()
 #include "disk_cache.h"
 #endif
 
+#if defined(COLORLCD)
+#include "bitmap_cache.h"
+#endif
+
+#if defined(LUA)
+#include "lua/lua_cache.h"
+#endif
+
 int cliDisplay(const char ** argv)
 {
   long long int address = 0;
@@ -1390,6 +1417,37 @@ int cliDisplay(const char ** argv)
     DiskCacheStats stats = diskCache.getStats();
     uint32_t hitRate = diskCache.getHitRate();
     cliSerialPrint("Disk Cache stats: w:%u r: %u, h: %u(%0.1f%%), m: %u", stats.noWrites, (stats.noHits + stats.noMisses), stats.noHits, hitRate*0.1f, stats.noMisses);
+    cliSerialPrint("Read-ahead: %u, used: %u", stats.noPrefetches, stats.noPrefetchHits);
+#if defined(DISK_CACHE_WRITE_BACK)
+    cliSerialPrint("Write-back: coalesced: %u, flushes: %u, max flush: %uus", stats.noCoalescedWrites, stats.noFlushes, stats.maxFlushDuration);
+#endif
+  }
+#endif
+#if defined(PROMPT_CACHE_SIZE)
+  else if (!strcmp(argv[1], "pc")) {
+    const PromptCacheStats & stats = promptCache.getStats();
+    uint32_t hitRate = promptCache.getHitRate();
+    cliSerialPrint("Prompt Cache stats: h: %u(%0.1f%%), m: %u, ins: %u, ev: %u, used: %u/%u", stats.noHits, hitRate*0.1f, stats.noMisses, stats.noInsertions, stats.noEvictions, stats.usedBytes, PROMPT_CACHE_SIZE);
+  }
+#endif
+#if defined(COLORLCD)
+  else if (!strcmp(argv[1], "bc")) {
+    const BitmapCacheStats & stats = bitmapCache.getStats();
+    uint32_t hitRate = bitmapCache.getHitRate();
+    cliSerialPrint("Bitmap Cache stats: h: %u(%0.1f%%), m: %u, ev: %u, used: %u", stats.noHits, hitRate*0.1f, stats.noMisses, stats.noEvictions, stats.usedBytes);
+    cliSerialPrint("Thumbnails: loaded: %u, saved: %u", stats.noThumbnailLoads, stats.noThumbnailSaves);
+  }
+#endif
+#if defined(LUA)
+  else if (!strcmp(argv[1], "lc")) {
+    const LuaCacheStats & stats = luaCache.getStats();
+    uint32_t hitRate = luaCache.getHitRate();
+    cliSerialPrint("Lua Cache stats: h: %u(%0.1f%%), m: %u, ins: %u", stats.noHits, hitRate*0.1f, stats.noMisses, stats.noInsertions);
+    cliSerialPrint("Lua loads: %u, total: %uus", stats.noLoads, stats.loadDuration);
+    for (uint8_t i = 0; i < stats.scriptsCount; i++) {
+      const LuaScriptLoadStats & script = stats.scripts[i];
+      cliSerialPrint("  %-16s loads: %u, last: %uus%s, max: %uus", script.name, script.noLoads, script.lastDuration, script.cached ? " (cached)" : "", script.maxDuration);
+    }
   }
 #endif
   else if (toLongLongInt(argv, 1, &address) > 0) {
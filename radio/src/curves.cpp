@@ -31,6 +31,18 @@ constexpr int CUSTOM_CURVE_POINTS(int p) { return 2 * p + (2 * DEFAULT_POINTS -
 
 int8_t * curveEnd[MAX_CURVES];
 
+// Smooth curves tangents, indexed like g_model.points and
+// computed once per curve (the 'curvesCompiled' bit is set)
+static int32_t curveTangents[MAX_CURVE_POINTS];
+static uint32_t curvesCompiled = 0;
+
+static_assert(MAX_CURVES <= 32, "curvesCompiled is too small");
+
+void invalidateCurves()
+{
+  curvesCompiled = 0;
+}
+
 uint8_t getCurvePoints(uint8_t index)
 {
   if (index >= MAX_CURVES)
@@ -77,6 +89,8 @@ void loadCurves()
   if (showWarning) {
     POPUP_WARNING("Invalid curve data repaired", "check your curves, logic switches");
   }
+
+  invalidateCurves();
 }
 
 int8_t * curveAddress(uint8_t idx)
@@ -100,6 +114,8 @@ static void curveMove_unsafe(uint8_t index, int8_t shift)
   while (index < MAX_CURVES) {
     curveEnd[index++] += shift;
   }
+
+  invalidateCurves();
 }
 
 bool moveCurve(uint8_t index, int8_t shift)
@@ -145,6 +161,8 @@ void curveClear(uint8_t index)
   if (shift != 0) {
     curveMove_unsafe(index, shift);
   }
+
+  invalidateCurves();
 }
 
 void curveMirror(uint8_t index)
@@ -158,6 +176,8 @@ void curveMirror(uint8_t index)
   // we only mirror Y axis: X axis does not change
   for (int i = 0; i < STD_CURVE_POINTS(curve.points); i++)
     points[i] = -points[i];
+
+  invalidateCurves();
 }
 
 bool isCurveUsed(uint8_t index)
@@ -228,6 +248,24 @@ int32_t compute_tangent(CurveHeader* crv, const int8_t* points, int i)
   return m;
 }
 
+static int32_t * getCurveTangents(uint8_t idx)
+{
+  int8_t * points = curveAddress(idx);
+  int32_t * tangents = &curveTangents[points - g_model.points];
+
+  if (!(curvesCompiled & (1u << idx))) {
+    // flagged first: an edit during the computation invalidates it again
+    curvesCompiled |= (1u << idx);
+    CurveHeader & crv = g_model.curves[idx];
+    uint8_t count = STD_CURVE_POINTS(crv.points);
+    for (int i = 0; i < count; i++) {
+      tangents[i] = compute_tangent(&crv, points, i);
+    }
+  }
+
+  return tangents;
+}
+
 /* The following is a hermite cubic spline.
    The basis functions can be found here:
    http://en.wikipedia.org/wiki/Cubic_Hermite_spline
@@ -239,13 +277,17 @@ int16_t hermite_spline(int16_t x, uint8_t idx)
   int8_t *points = curveAddress(idx);
   uint8_t count = STD_CURVE_POINTS(crv.points);
   bool custom = (crv.type == CURVE_TYPE_CUSTOM);
+  int32_t *tangents = getCurveTangents(idx);
 
   if (x < -RESX)
     x = -RESX;
   else if (x > RESX)
     x = RESX;
 
-  for (int i=0; i<count-1; i++) {
+  // standard curves: the segment is found directly
+  int first = custom ? 0 : min<int>(((x + RESX) * (count-1)) / (2*RESX), count-2);
+
+  for (int i=first; i<count-1; i++) {
     int32_t p0x, p3x;
     if (custom) {
       p0x = (i>0 ? calc100toRESX(points[count+i-1]) : -RESX);
@@ -259,8 +301,8 @@ int16_t hermite_spline(int16_t x, uint8_t idx)
     if (x >= p0x && x <= p3x) {
       int32_t p0y = calc100toRESX(points[i]);
       int32_t p3y = calc100toRESX(points[i+1]);
-      int32_t m0 = compute_tangent(&crv, points, i);
-      int32_t m3 = compute_tangent(&crv, points, i+1);
+      int32_t m0 = tangents[i];
+      int32_t m3 = tangents[i+1];
       int32_t y;
       int32_t h = p3x - p0x;
       int32_t t = (h > 0 ? (MMULT * (x - p0x)) / h : 0);
@@ -392,7 +392,7 @@ PACK(struct TelemetrySensor {
   uint8_t  logs:1;
   uint8_t  persistent:1;
   uint8_t  onlyPositive:1;
-  uint8_t  spare2:1 SKIP;
+  uint8_t  logsHighRate:1;
   union {
     NOBACKUP(PACK(struct {
       uint16_t ratio;
@@ -21,6 +21,7 @@
 
 #include "opentx.h"
 #include "stamp.h"
+#include "timers_driver.h"
 #include <stdarg.h>
 
 #if defined(SIMU)
@@ -122,13 +123,13 @@ struct InterruptCounters interruptCounters;
 
 void DebugTimer::start()
 {
-  _start_hiprec = getTmr2MHz();
+  _start_hiprec = timersGetUsTick();
   _start_loprec = get_tmr10ms();
 }
 
 void DebugTimer::stop()
 {
-  // getTmr2MHz is 16 bit timer, resolution 0.5us, max measurable value 32.7675 milli seconds
+  // timersGetUsTick is 32 bit timer, resolution 1us, max measurable value 71 minutes
   // tmr10ms_t tmr10ms = get_tmr10ms(); 32 bit timer, resolution 10ms, max measurable value: 42949672.95 s = 1.3 years
   // if time difference is bigger than 30ms, then use low resolution timer
   // otherwise use high resolution
@@ -137,7 +138,7 @@ void DebugTimer::stop()
   last = get_tmr10ms() - _start_loprec;  //use low precision timer
   if (last < 3) {
     //use high precision
-    last = (uint16_t)(getTmr2MHz() - _start_hiprec) / 2;
+    last = timersGetUsTick() - _start_hiprec;
   }
   else {
     last *= 10000ul; //adjust unit to 1us
@@ -171,6 +172,8 @@ const char * const debugTimerNames[DEBUG_TIMERS_COUNT] = {
   ,"Mix ADC    "   // debugTimerGetAdc
   ,"Mix getsw  "   // debugTimerGetSwitches
   ,"Mix eval   "   // debugTimerEvalMixes
+  ,"Mix LS eval"   // debugTimerEvalLogicalSwitches
+  ,"Mix funcs  "   // debugTimerEvalFunctions
   ,"Mix 10ms   "   // debugTimerMixes10ms
   ,"ADC read   "   // debugTimerAdcRead
   ,"mix-pulses "   // debugTimerMixerCalcToUsage
@@ -178,7 +181,11 @@ const char * const debugTimerNames[DEBUG_TIMERS_COUNT] = {
   ,"Audio int. "   // debugTimerAudioIterval
   ,"Audio dur. "   // debugTimerAudioDuration
   ," A. consume"   // debugTimerAudioConsume
+  ,"YAML scan  "   // debugTimerYamlScan
+  ,"YAML load  "   // debugTimerYamlLoad
+#if defined(SPACEMOUSE)
   ,"SpaceMouse "   // debugTimerSpaceMouseWakeup
+#endif
 };
 
 #endif
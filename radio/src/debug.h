@@ -331,7 +331,7 @@ private:
   // debug_timer_t avg;
   debug_timer_t last;   //unit 1us
 
-  uint16_t _start_hiprec;
+  uint32_t _start_hiprec;
   uint32_t _start_loprec;
 
   void evalStats() {
@@ -379,6 +379,8 @@ enum DebugTimers {
   debugTimerGetAdc,
   debugTimerGetSwitches,
   debugTimerEvalMixes,
+  debugTimerEvalLogicalSwitches,
+  debugTimerEvalFunctions,
   debugTimerMixes10ms,
 
   debugTimerAdcRead,
@@ -390,6 +392,7 @@ enum DebugTimers {
   debugTimerAudioDuration,
   debugTimerAudioConsume,
   debugTimerYamlScan,
+  debugTimerYamlLoad,
 
 #if defined(SPACEMOUSE)
   debugTimerSpacemouseWakeup,
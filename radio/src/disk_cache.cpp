@@ -21,6 +21,7 @@
 
 #include "disk_cache.h"
 #include "sdcard.h"
+#include "timers_driver.h"
 
 #include <string.h>
 
@@ -43,149 +44,441 @@ DiskCache diskCache;
 class DiskCacheBlock
 {
  public:
-  DiskCacheBlock();
-  bool read(BYTE* buff, DWORD sector, UINT count);
-  DRESULT fill(const diskio_driver_t* drv, BYTE lun, BYTE* buff, DWORD sector,
-               UINT count);
-  void free(DWORD sector, UINT count);
-  void free();
-  bool empty() const;
-
- private:
   uint8_t data[DISK_CACHE_BLOCK_SIZE];
-  DWORD startSector;
-  DWORD endSector;
+  DWORD block;        // block number (first sector / DISK_CACHE_BLOCK_SECTORS)
+  int8_t prev;        // LRU list
+  int8_t next;
+  int8_t hashNext;    // hash bucket chain
+  bool valid;
+  bool prefetched;    // read ahead, not yet used
 };
 
-DiskCacheBlock::DiskCacheBlock():
-  startSector(0),
-  endSector(0) 
+static inline uint8_t hashBucket(DWORD block)
 {
+  return block & (DISK_CACHE_HASH_SIZE - 1);
 }
 
-bool DiskCacheBlock::read(BYTE * buff, DWORD sector, UINT count)
+DiskCache::DiskCache() :
+  blocks(nullptr),
+  diskDrv(nullptr),
+  sectors(0),
+  lruHead(-1),
+  lruTail(-1),
+  prefetchBlock(0),
+  prefetchLun(0)
+#if defined(DISK_CACHE_WRITE_BACK)
+  , writeBuffer(nullptr),
+  writeStart(0),
+  writeCount(0),
+  writeLun(0),
+  writeTime(0)
+#endif
+{
+  memset(&stats, 0, sizeof(stats));
+  memset(hash, -1, sizeof(hash));
+  memset(streams, 0, sizeof(streams));
+}
+
+void DiskCache::initialize(const diskio_driver_t* drv)
 {
-  if (sector >= startSector && (sector+count) <= endSector) {
-    TRACE_DISK_CACHE("\tcache read(%u, %u) from %p", (uint32_t)sector, (uint32_t)count, this);
-    memcpy(buff, data + ((sector - startSector) * BLOCK_SIZE), count * BLOCK_SIZE);
-    return true;
+  blocks = new DiskCacheBlock[DISK_CACHE_BLOCKS_NUM];
+#if defined(DISK_CACHE_WRITE_BACK)
+  writeBuffer = new uint8_t[DISK_CACHE_WRITE_SECTORS * BLOCK_SIZE];
+#endif
+  diskDrv = drv;
+  clear();
+}
+
+void DiskCache::clear()
+{
+  memset(&stats, 0, sizeof(stats));
+  memset(hash, -1, sizeof(hash));
+  memset(streams, 0, sizeof(streams));
+  sectors = 0;
+  prefetchBlock = 0;
+#if defined(DISK_CACHE_WRITE_BACK)
+  // called before mounting: a new card may have been inserted
+  writeCount = 0;
+#endif
+
+  if (!blocks) return;
+
+  for (int n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
+    blocks[n].prev = n - 1;
+    blocks[n].next = (n + 1 < DISK_CACHE_BLOCKS_NUM) ? n + 1 : -1;
+    blocks[n].hashNext = -1;
+    blocks[n].valid = false;
+    blocks[n].prefetched = false;
   }
-  return false;
+  lruHead = 0;
+  lruTail = DISK_CACHE_BLOCKS_NUM - 1;
 }
 
-DRESULT DiskCacheBlock::fill(const diskio_driver_t* drv, BYTE lun, BYTE * buff,
-			     DWORD sector, UINT count)
+uint32_t DiskCache::getSectors(uint8_t lun)
 {
-  DRESULT res = drv->read(lun, data, sector, DISK_CACHE_BLOCK_SECTORS);
-  if (res != RES_OK) {
-    return res;
+  if (sectors == 0) {
+    diskDrv->ioctl(lun, GET_SECTOR_COUNT, &sectors);
   }
-  startSector = sector;
-  endSector = sector + DISK_CACHE_BLOCK_SECTORS;
-  memcpy(buff, data, count * BLOCK_SIZE);
-  TRACE_DISK_CACHE("cache %p FILLED from read(%u, %u)", this, (uint32_t)sector, (uint32_t)count);
-  return RES_OK;
+  return sectors;
 }
 
-void DiskCacheBlock::free(DWORD sector, UINT count) 
+void DiskCache::lruUnlink(DiskCacheBlock* b)
 {
-  if (sector < endSector && (sector+count) > startSector) {
-    TRACE_DISK_CACHE("\tINVALIDATING disk cache block %p (%u)", this, startSector);
-    endSector = 0;
+  if (b->prev >= 0) blocks[b->prev].next = b->next;
+  else lruHead = b->next;
+  if (b->next >= 0) blocks[b->next].prev = b->prev;
+  else lruTail = b->prev;
+}
+
+void DiskCache::lruPushHead(DiskCacheBlock* b)
+{
+  int8_t idx = b - blocks;
+  b->prev = -1;
+  b->next = lruHead;
+  if (lruHead >= 0) blocks[lruHead].prev = idx;
+  else lruTail = idx;
+  lruHead = idx;
+}
+
+void DiskCache::lruPushTail(DiskCacheBlock* b)
+{
+  int8_t idx = b - blocks;
+  b->next = -1;
+  b->prev = lruTail;
+  if (lruTail >= 0) blocks[lruTail].next = idx;
+  else lruHead = idx;
+  lruTail = idx;
+}
+
+void DiskCache::hashInsert(DiskCacheBlock* b)
+{
+  uint8_t bucket = hashBucket(b->block);
+  b->hashNext = hash[bucket];
+  hash[bucket] = b - blocks;
+}
+
+void DiskCache::hashRemove(DiskCacheBlock* b)
+{
+  int8_t idx = b - blocks;
+  int8_t* link = &hash[hashBucket(b->block)];
+  while (*link >= 0) {
+    if (*link == idx) {
+      *link = b->hashNext;
+      break;
+    }
+    link = &blocks[*link].hashNext;
   }
+  b->hashNext = -1;
 }
 
-void DiskCacheBlock::free()
+DiskCacheBlock* DiskCache::find(DWORD block)
 {
-  endSector = 0;
+  for (int8_t n = hash[hashBucket(block)]; n >= 0; n = blocks[n].hashNext) {
+    if (blocks[n].block == block) {
+      return &blocks[n];
+    }
+  }
+  return nullptr;
 }
 
-bool DiskCacheBlock::empty() const
+// Takes the least recently used block and makes it the most recent one
+DiskCacheBlock* DiskCache::allocate(DWORD block)
 {
-  return (endSector == 0);
+  DiskCacheBlock* b = &blocks[lruTail];
+  if (b->valid) {
+    TRACE_DISK_CACHE("	evicting block %u", (uint32_t)b->block);
+    hashRemove(b);
+  }
+  b->block = block;
+  b->valid = true;
+  b->prefetched = false;
+  hashInsert(b);
+  lruUnlink(b);
+  lruPushHead(b);
+  return b;
 }
 
-DiskCache::DiskCache() : lastBlock(0), blocks(nullptr), diskDrv(nullptr)
+void DiskCache::invalidate(DiskCacheBlock* b)
 {
-  stats.noHits = 0;
-  stats.noMisses = 0;
-  stats.noWrites = 0;
+  TRACE_DISK_CACHE("	INVALIDATING disk cache block %u", (uint32_t)b->block);
+  hashRemove(b);
+  b->valid = false;
+  b->prefetched = false;
+  lruUnlink(b);
+  lruPushTail(b);
 }
 
-void DiskCache::initialize(const diskio_driver_t* drv)
+// Reads from the disk, the pending writes being flushed first
+DRESULT DiskCache::driverRead(BYTE lun, BYTE* buff, DWORD sector, UINT count)
 {
-  blocks = new DiskCacheBlock[DISK_CACHE_BLOCKS_NUM];
-  diskDrv = drv;
+#if defined(DISK_CACHE_WRITE_BACK)
+  if (writeCount > 0 && lun == writeLun && sector < writeStart + writeCount &&
+      sector + count > writeStart) {
+    DRESULT res = flush();
+    if (res != RES_OK) return res;
+  }
+#endif
+  return diskDrv->read(lun, buff, sector, count);
 }
 
-void DiskCache::clear()
+// Reads 'count' sectors, all within the same cache block
+DRESULT DiskCache::readBlock(BYTE lun, BYTE* buff, DWORD sector, UINT count,
+                             bool sequential)
 {
-  lastBlock = 0;
-  stats.noHits = 0;
-  stats.noMisses = 0;
-  stats.noWrites = 0;
-  for (int n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
-    blocks[n].free();
+  DWORD block = sector / DISK_CACHE_BLOCK_SECTORS;
+  UINT offset = sector % DISK_CACHE_BLOCK_SECTORS;
+
+  // partial block at the end of the disk: read it directly
+  if ((block + 1) * DISK_CACHE_BLOCK_SECTORS > getSectors(lun)) {
+    TRACE_DISK_CACHE("cache would be beyond end of disk %u (%u)",
+                     (uint32_t)sector, getSectors(lun));
+    return driverRead(lun, buff, sector, count);
+  }
+
+  DiskCacheBlock* b = find(block);
+  if (b) {
+    TRACE_DISK_CACHE("	cache read(%u, %u) from block %u", (uint32_t)sector,
+                     (uint32_t)count, (uint32_t)block);
+    ++stats.noHits;
+    if (b->prefetched) {
+      ++stats.noPrefetchHits;
+      b->prefetched = false;
+    }
+    lruUnlink(b);
+    lruPushHead(b);
+  } else {
+    ++stats.noMisses;
+    b = allocate(block);
+    DRESULT res = driverRead(lun, b->data, block * DISK_CACHE_BLOCK_SECTORS,
+                                DISK_CACHE_BLOCK_SECTORS);
+    if (res != RES_OK) {
+      invalidate(b);
+      return res;
+    }
+    TRACE_DISK_CACHE("cache block %u FILLED from read(%u, %u)",
+                     (uint32_t)block, (uint32_t)sector, (uint32_t)count);
+  }
+
+  memcpy(buff, b->data + offset * BLOCK_SIZE, count * BLOCK_SIZE);
+
+  // a sequential stream will not come back to a block it has
+  // read to the end: let it be evicted first, so that streaming
+  // a file does not flush the rest of the cache
+  if (sequential && offset + count == DISK_CACHE_BLOCK_SECTORS) {
+    lruUnlink(b);
+    lruPushTail(b);
   }
+
+  return RES_OK;
 }
 
-uint32_t DiskCache::getSectors(uint8_t lun)
+// Returns the stream continued by this read, if any,
+// the least recently used one being replaced otherwise
+DiskCacheStream* DiskCache::updateStreams(DWORD sector, UINT count)
 {
-  if (sectors == 0) {
-    diskDrv->ioctl(lun, GET_SECTOR_COUNT, &sectors);
+  DiskCacheStream* stream = nullptr;
+  DiskCacheStream* oldest = &streams[0];
+
+  for (int n = 0; n < DISK_CACHE_STREAMS_NUM; ++n) {
+    DiskCacheStream* s = &streams[n];
+    if (s->length > 0 && s->end == sector && !stream) {
+      stream = s;
+    } else {
+      if (s->age < 255) ++s->age;
+      if (s->age > oldest->age) oldest = s;
+    }
   }
-  return sectors;
+
+  if (stream) {
+    if (stream->length < 255) ++stream->length;
+  } else {
+    stream = oldest;
+    stream->length = 1;
+  }
+  stream->end = sector + count;
+  stream->age = 0;
+  return stream;
 }
 
 DRESULT DiskCache::read(BYTE lun, BYTE * buff, DWORD sector, UINT count)
 {
+  DiskCacheStream* stream = updateStreams(sector, count);
+  bool sequential = stream->length >= 3;
+
+  DRESULT res = RES_OK;
+
   // if read is bigger than cache block, then read it directly without using cache
   if (count > DISK_CACHE_BLOCK_SECTORS) {
     TRACE_DISK_CACHE("big read(%u, %u)",  (uint32_t)sector, (uint32_t)count);
-    return diskDrv->read(lun, buff, sector, count);
+    res = driverRead(lun, buff, sector, count);
+  } else {
+    while (count > 0 && res == RES_OK) {
+      UINT n = DISK_CACHE_BLOCK_SECTORS - (sector % DISK_CACHE_BLOCK_SECTORS);
+      if (n > count) n = count;
+      res = readBlock(lun, buff, sector, n, sequential);
+      buff += n * BLOCK_SIZE;
+      sector += n;
+      count -= n;
+    }
   }
-  
-  // if block + cache block size is beyond the end of the disk,
-  // then read it directly without using cache
-  if (sector + DISK_CACHE_BLOCK_SECTORS >= getSectors(lun)) {
-    TRACE_DISK_CACHE("cache would be beyond end of disk %u (%u)",
-		     (uint32_t)sector, getSectors(lun));
-    return diskDrv->read(lun, buff, sector, count);
+
+  // sequential stream: ask for the block it will need next
+  if (res == RES_OK && sequential) {
+    DWORD block = stream->end / DISK_CACHE_BLOCK_SECTORS;
+    if (find(block)) ++block;
+    if (!find(block)) {
+      prefetchBlock = block;
+      prefetchLun = lun;
+    }
   }
 
-  for (int n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
-    if (blocks[n].read(buff, sector, count)) {
-      ++stats.noHits;
+  return res;
+}
+
+void DiskCache::prefetch()
+{
+  if (!blocks || prefetchBlock == 0) return;
+
+  DWORD block = prefetchBlock;
+  prefetchBlock = 0;
+
+  if (find(block) ||
+      (block + 1) * DISK_CACHE_BLOCK_SECTORS > getSectors(prefetchLun)) {
+    return;
+  }
+
+  DiskCacheBlock* b = allocate(block);
+  if (driverRead(prefetchLun, b->data, block * DISK_CACHE_BLOCK_SECTORS,
+                    DISK_CACHE_BLOCK_SECTORS) != RES_OK) {
+    invalidate(b);
+    return;
+  }
+
+  TRACE_DISK_CACHE("cache block %u PREFETCHED", (uint32_t)block);
+  b->prefetched = true;
+  ++stats.noPrefetches;
+}
+
+#if defined(DISK_CACHE_WRITE_BACK)
+DRESULT DiskCache::bufferWrite(BYTE lun, const BYTE* buff, DWORD sector,
+                               UINT count)
+{
+  if (writeCount > 0) {
+    // rewrite of, or append to the pending run
+    if (lun == writeLun && sector >= writeStart &&
+        sector <= writeStart + writeCount &&
+        sector + count <= writeStart + DISK_CACHE_WRITE_SECTORS) {
+      memcpy(writeBuffer + (sector - writeStart) * BLOCK_SIZE, buff,
+             count * BLOCK_SIZE);
+      if (sector + count > writeStart + writeCount) {
+        writeCount = sector + count - writeStart;
+      }
+      ++stats.noCoalescedWrites;
       return RES_OK;
     }
+
+    DRESULT res = flush();
+    if (res != RES_OK) return res;
   }
 
-  ++stats.noMisses;
+  if (count > DISK_CACHE_WRITE_SECTORS) {
+    return diskDrv->write(lun, buff, sector, count);
+  }
 
-  // find free block
-  for (int n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
-    if (blocks[n].empty()) {
-      TRACE_DISK_CACHE("\t\t using free block");
-      return blocks[n].fill(diskDrv, lun, buff, sector, count);
+  memcpy(writeBuffer, buff, count * BLOCK_SIZE);
+  writeStart = sector;
+  writeCount = count;
+  writeLun = lun;
+  writeTime = timersGetUsTick();
+  return RES_OK;
+}
+#endif
+
+DRESULT DiskCache::flush()
+{
+#if defined(DISK_CACHE_WRITE_BACK)
+  if (writeCount == 0) return RES_OK;
+
+  uint32_t start = timersGetUsTick();
+  DRESULT res = diskDrv->write(writeLun, writeBuffer, writeStart, writeCount);
+  uint32_t duration = timersGetUsTick() - start;
+
+  TRACE_DISK_CACHE("flush(%u, %u) = %d in %uus", (uint32_t)writeStart,
+                   (uint32_t)writeCount, res, duration);
+
+  // on error the data is kept, to be written again on the next flush
+  if (res == RES_OK) {
+    writeCount = 0;
+    ++stats.noFlushes;
+    if (duration > stats.maxFlushDuration) {
+      stats.maxFlushDuration = duration;
     }
   }
+  return res;
+#else
+  return RES_OK;
+#endif
+}
 
-  // use next block (round robin)
-  // TODO: use better strategy to select which used block gets used here
-  if (++lastBlock >= DISK_CACHE_BLOCKS_NUM) {
-    lastBlock = 0;
+void DiskCache::flushExpired()
+{
+#if defined(DISK_CACHE_WRITE_BACK)
+  if (writeCount > 0 &&
+      timersGetUsTick() - writeTime >= DISK_CACHE_WRITE_DELAY * 1000) {
+    flush();
   }
-  
-  return blocks[lastBlock].fill(diskDrv, lun, buff, sector, count);
+#endif
 }
 
+// The cached copies are updated with the written data
 DRESULT DiskCache::write(BYTE lun, const BYTE* buff, DWORD sector, UINT count)
 {
   ++stats.noWrites;
-  for(int n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
-    blocks[n].free(sector, count);
+#if defined(DISK_CACHE_WRITE_BACK)
+  DRESULT res = bufferWrite(lun, buff, sector, count);
+#else
+  DRESULT res = diskDrv->write(lun, buff, sector, count);
+#endif
+
+  DWORD first = sector / DISK_CACHE_BLOCK_SECTORS;
+  DWORD last = (sector + count - 1) / DISK_CACHE_BLOCK_SECTORS;
+
+  // a big write may not hit any cached block: avoid looking them all up
+  if (last - first >= DISK_CACHE_BLOCKS_NUM) {
+    for (int n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
+      DiskCacheBlock* b = &blocks[n];
+      if (b->valid && b->block >= first && b->block <= last) {
+        invalidate(b);
+      }
+    }
+    return res;
+  }
+
+  for (DWORD block = first; block <= last; ++block) {
+    DiskCacheBlock* b = find(block);
+    if (!b) continue;
+    if (res != RES_OK) {
+      invalidate(b);
+      continue;
+    }
+    DWORD blockStart = block * DISK_CACHE_BLOCK_SECTORS;
+    DWORD blockEnd = blockStart + DISK_CACHE_BLOCK_SECTORS;
+    DWORD start = sector > blockStart ? sector : blockStart;
+    DWORD end = sector + count < blockEnd ? sector + count : blockEnd;
+    memcpy(b->data + (start - blockStart) * BLOCK_SIZE,
+           buff + (start - sector) * BLOCK_SIZE, (end - start) * BLOCK_SIZE);
+  }
+
+  return res;
+}
+
+DRESULT DiskCache::ioctl(BYTE lun, BYTE cmd, void* buff)
+{
+  if (cmd == CTRL_SYNC) {
+    DRESULT res = flush();
+    if (res != RES_OK) return res;
   }
-  return diskDrv->write(lun, buff, sector, count);
+  return diskDrv->ioctl(lun, cmd, buff);
 }
 
 const DiskCacheStats & DiskCache::getStats() const 
@@ -210,3 +503,8 @@ DRESULT disk_cache_write(BYTE drv, const BYTE * buff, DWORD sector, UINT count)
   return diskCache.write(drv, buff, sector, count);
 }
 
+DRESULT disk_cache_ioctl(BYTE drv, BYTE cmd, void* buff)
+{
+  return diskCache.ioctl(drv, cmd, buff);
+}
+
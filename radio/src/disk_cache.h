@@ -26,16 +26,36 @@
 // tunable parameters
 #define DISK_CACHE_BLOCKS_NUM      32   // no cache blocks
 #define DISK_CACHE_BLOCK_SECTORS   16   // no sectors
+#define DISK_CACHE_HASH_SIZE       64   // no hash buckets (power of 2)
+#define DISK_CACHE_STREAMS_NUM     4    // no sequential streams tracked
+#define DISK_CACHE_WRITE_SECTORS   16   // no sectors coalesced (write-back)
+#define DISK_CACHE_WRITE_DELAY     500  // ms before pending writes are flushed
 
 struct DiskCacheStats
 {
   uint32_t noHits;
   uint32_t noMisses;
   uint32_t noWrites;
+  uint32_t noPrefetches;    // blocks read ahead
+  uint32_t noPrefetchHits;  // blocks read ahead which have been used
+  uint32_t noCoalescedWrites;  // writes merged into pending ones
+  uint32_t noFlushes;          // pending writes written to the disk
+  uint32_t maxFlushDuration;   // us
 };
 
 class DiskCacheBlock;
 
+struct DiskCacheStream
+{
+  DWORD end;       // sector following the last read
+  uint8_t length;  // number of consecutive sequential reads
+  uint8_t age;     // reads since the last one of this stream
+};
+
+// Cache of aligned blocks of DISK_CACHE_BLOCK_SECTORS sectors:
+// - blocks are found with a hash index, and evicted in LRU order
+// - sequential reads are detected, the block following the stream
+//   being read ahead by prefetch(), outside of the reader's context
 class DiskCache
 {
  public:
@@ -46,23 +66,70 @@ class DiskCache
 
   DRESULT read(BYTE drv, BYTE* buff, DWORD sector, UINT count);
   DRESULT write(BYTE drv, const BYTE* buff, DWORD sector, UINT count);
+  DRESULT ioctl(BYTE drv, BYTE cmd, void* buff);
+
+  // Writes the pending data, if any (write-back only)
+  DRESULT flush();
+
+  // Flushes the pending data older than DISK_CACHE_WRITE_DELAY.
+  // The caller must ensure no other disk access is in progress.
+  void flushExpired();
+
+  // Reads the block requested by a sequential stream, if any.
+  // The caller must ensure no other disk access is in progress.
+  void prefetch();
 
   const DiskCacheStats& getStats() const;
   int getHitRate() const;
 
  private:
   DiskCacheStats stats;
-  uint32_t lastBlock;
   DiskCacheBlock* blocks;
   const diskio_driver_t* diskDrv;
   uint32_t sectors;
 
+  int8_t hash[DISK_CACHE_HASH_SIZE];
+  int8_t lruHead;  // most recently used
+  int8_t lruTail;  // least recently used
+
+  // several files may be read at the same time (WAV, FAT, directories)
+  DiskCacheStream streams[DISK_CACHE_STREAMS_NUM];
+  DWORD prefetchBlock;   // next block of a stream, 0 if none
+  BYTE prefetchLun;
+
+#if defined(DISK_CACHE_WRITE_BACK)
+  // a single run of consecutive sectors is kept pending, any other
+  // write flushing it first: the disk is written in the same order
+  // as FatFs does (data, then FAT / directory entries)
+  uint8_t* writeBuffer;
+  DWORD writeStart;
+  UINT writeCount;
+  BYTE writeLun;
+  uint32_t writeTime;
+
+  DRESULT bufferWrite(BYTE lun, const BYTE* buff, DWORD sector, UINT count);
+#endif
+
   uint32_t getSectors(uint8_t lun);
+
+  DiskCacheBlock* find(DWORD block);
+  DiskCacheBlock* allocate(DWORD block);
+  void invalidate(DiskCacheBlock* b);
+  void lruUnlink(DiskCacheBlock* b);
+  void lruPushHead(DiskCacheBlock* b);
+  void lruPushTail(DiskCacheBlock* b);
+  void hashInsert(DiskCacheBlock* b);
+  void hashRemove(DiskCacheBlock* b);
+  DiskCacheStream* updateStreams(DWORD sector, UINT count);
+  DRESULT driverRead(BYTE lun, BYTE* buff, DWORD sector, UINT count);
+  DRESULT readBlock(BYTE lun, BYTE* buff, DWORD sector, UINT count,
+                    bool sequential);
 };
 
 extern DiskCache diskCache;
 
 DRESULT disk_cache_read(BYTE drv, BYTE* buff, DWORD sector, UINT count);
 DRESULT disk_cache_write(BYTE drv, const BYTE* buff, DWORD sector, UINT count);
+DRESULT disk_cache_ioctl(BYTE drv, BYTE cmd, void* buff);
 
 
@@ -127,9 +127,100 @@ bool isRepeatDelayElapsed(const CustomFunctionData * functions, CustomFunctionsC
   }
 }
 
+// How a function behaves while its switch stays active
+enum FunctionTrigger {
+  FUNCTION_LEVEL,   // applied on each tick
+  FUNCTION_EDGE,    // only does something when activated
+  FUNCTION_REPEAT,  // runs again once its repeat period is elapsed
+};
+
+static uint8_t getFunctionTrigger(const CustomFunctionData * cfn)
+{
+  switch (CFN_FUNC(cfn)) {
+    case FUNC_RESET:
+      return CFN_PARAM(cfn) == FUNC_RESET_FLIGHT ? FUNCTION_EDGE : FUNCTION_LEVEL;
+
+#if defined(GVARS)
+    case FUNC_ADJUST_GVAR:
+      return CFN_GVAR_MODE(cfn) == FUNC_ADJUST_GVAR_INCDEC ? FUNCTION_EDGE : FUNCTION_LEVEL;
+#endif
+
+    case FUNC_SCREENSHOT:
+      return FUNCTION_EDGE;
+
+#if defined(SDCARD)
+    case FUNC_PLAY_SOUND:
+    case FUNC_PLAY_TRACK:
+    case FUNC_PLAY_VALUE:
+#if defined(HAPTIC)
+    case FUNC_HAPTIC:
+#endif
+      return FUNCTION_REPEAT;
+#endif
+
+#if defined(COLORLCD)
+    case FUNC_SET_SCREEN:
+      return FUNCTION_REPEAT;
+#endif
+
+    default:
+      return FUNCTION_LEVEL;
+  }
+}
+
+// Schedules the next run of a repeated function, after it has run
+static void scheduleRepeat(const CustomFunctionData * cfn, CustomFunctionsContext & functionsContext, uint8_t index)
+{
+  tmr10ms_t time = functionsContext.lastFunctionTime[index];
+  int8_t repeatParam = CFN_PLAY_REPEAT(cfn);
+  if (time) {
+    if (!repeatParam || repeatParam == CFN_PLAY_REPEAT_NOSTART)
+      return;  // played only once
+    time += 100 * repeatParam;
+  }
+
+  if (!functionsContext.repeatPending || (int32_t)(time - functionsContext.nextRepeatTime) < 0) {
+    functionsContext.nextRepeatTime = time;
+    functionsContext.repeatPending = true;
+  }
+}
+
+static void buildFunctionsDispatch(const CustomFunctionData * functions, CustomFunctionsContext & functionsContext)
+{
+  functionsContext.slotsCount = 0;
+  for (uint8_t i=0; i<MAX_SPECIAL_FUNCTIONS; i++) {
+    if (CFN_SWITCH(&functions[i]))
+      functionsContext.slots[functionsContext.slotsCount++] = i;
+  }
+  functionsContext.slotsBuilt = true;
+}
+
+void invalidateFunctionsDispatch()
+{
+  globalFunctionsContext.slotsBuilt = false;
+  modelFunctionsContext.slotsBuilt = false;
+}
+
+#if defined(OVERRIDE_CHANNEL_FUNCTION)
+// safetyCh[] is zeroed at startup, it is reset by the first evaluation
+static bool overridesSet = true;
+#endif
+
+#if defined(GVARS)
+static bool trimGvarsSet = true;
+#endif
+
 #define VOLUME_HYSTERESIS 10            // how much must a input value change to actually be considered for new volume setting
 getvalue_t requiredSpeakerVolumeRawLast = 1024 + 1; //initial value must be outside normal range
 
+// Only the functions with a switch are visited (the list is built again
+// after each model / radio settings change), and among them:
+// - the switch of a function triggered by a logical switch is only read
+//   when this logical switch changed since the previous tick
+// - an active function is only run again when it does something on
+//   each tick: once activated, the edge triggered functions wait for
+//   their switch to change, and the repeated ones for the earliest
+//   repeat time of the context
 void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext & functionsContext)
 {
   MASK_FUNC_TYPE newActiveFunctions  = 0;
@@ -138,33 +229,74 @@ void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext
   uint8_t playFirstIndex = (functions == g_model.customFn ? 1 : 1+MAX_SPECIAL_FUNCTIONS);
   #define PLAY_INDEX   (i+playFirstIndex)
 
+  // after a change, all functions are evaluated as on the first tick
+  bool evalAll = !functionsContext.slotsBuilt;
+  if (evalAll) {
+    buildFunctionsDispatch(functions, functionsContext);
+  }
+
+  uint64_t lswStates = getLogicalSwitchesStates();
+  uint64_t lswChanged = evalAll ? (uint64_t)-1 : lswStates ^ functionsContext.lswStates;
+  functionsContext.lswStates = lswStates;
+
+  bool repeatDue = evalAll ||
+      (functionsContext.repeatPending &&
+       (int32_t)(get_tmr10ms() - functionsContext.nextRepeatTime) >= 0);
+  if (repeatDue) {
+    functionsContext.repeatPending = false;
+  }
+
 #if defined(OVERRIDE_CHANNEL_FUNCTION)
-  for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++) {
-    safetyCh[i] = OVERRIDE_CHANNEL_UNDEFINED;
+  if (overridesSet) {
+    for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++) {
+      safetyCh[i] = OVERRIDE_CHANNEL_UNDEFINED;
+    }
+    overridesSet = false;
   }
 #endif
 
 #if defined(GVARS)
-  for (uint8_t i=0; i<MAX_TRIMS; i++) {
-    trimGvar[i] = -1;
+  if (trimGvarsSet) {
+    for (uint8_t i=0; i<MAX_TRIMS; i++) {
+      trimGvar[i] = -1;
+    }
+    trimGvarsSet = false;
   }
 #endif
 
-  for (uint8_t i=0; i<MAX_SPECIAL_FUNCTIONS; i++) {
+  for (uint8_t slot=0; slot<functionsContext.slotsCount; slot++) {
+    uint8_t i = functionsContext.slots[slot];
     const CustomFunctionData * cfn = &functions[i];
     swsrc_t swtch = CFN_SWITCH(cfn);
     if (swtch) {
       MASK_CFN_TYPE switch_mask = ((MASK_CFN_TYPE)1 << i);
+      bool wasActive = functionsContext.activeSwitches & switch_mask;
 
-      bool active = getSwitch(swtch, IS_PLAY_FUNC(CFN_FUNC(cfn)) ? GETSWITCH_MIDPOS_DELAY : 0);
-      if (CFN_ACTIVE(cfn) == 0)
-        active = false;
+      bool active;
+      uint16_t lsw = abs(swtch) - SWSRC_FIRST_LOGICAL_SWITCH;
+      if (lsw < MAX_LOGICAL_SWITCHES && !(lswChanged & ((uint64_t)1 << lsw))) {
+        active = wasActive;
+      }
+      else {
+        active = getSwitch(swtch, IS_PLAY_FUNC(CFN_FUNC(cfn)) ? GETSWITCH_MIDPOS_DELAY : 0);
+        if (CFN_ACTIVE(cfn) == 0)
+          active = false;
+      }
+
+      if (active && wasActive && !evalAll) {
+        uint8_t trigger = getFunctionTrigger(cfn);
+        if (trigger == FUNCTION_EDGE || (trigger == FUNCTION_REPEAT && !repeatDue)) {
+          newActiveSwitches |= switch_mask;
+          continue;
+        }
+      }
 
       if (active) {
         switch (CFN_FUNC(cfn)) {
 #if defined(OVERRIDE_CHANNEL_FUNCTION)
           case FUNC_OVERRIDE_CHANNEL:
             safetyCh[CFN_CH_INDEX(cfn)] = CFN_PARAM(cfn);
+            overridesSet = true;
             break;
 #endif
 
@@ -263,6 +395,7 @@ void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext
                        CFN_PARAM(cfn) <= MIXSRC_LAST_TRIM) {
               trimGvar[CFN_PARAM(cfn) - MIXSRC_FIRST_TRIM] =
                   CFN_GVAR_INDEX(cfn);
+              trimGvarsSet = true;
             } else {
               SET_GVAR(CFN_GVAR_INDEX(cfn),
                        limit<int16_t>(MODEL_GVAR_MIN(CFN_GVAR_INDEX(cfn)),
@@ -310,6 +443,7 @@ void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext
                 }
               }
             }
+            scheduleRepeat(cfn, functionsContext, i);
             break;
           }
 
@@ -376,6 +510,8 @@ void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext
               newActiveFunctions |= (1u << FUNCTION_LOGS);
               logDelay100ms = CFN_PARAM(
                   cfn);  // logging period is 0..25.5s in 100ms increments
+              logHighRate10ms = CFN_LOGS_HIGH_RATE(
+                  cfn);  // high rate period is 10..90ms, 0 when disabled
             }
             break;
 #endif
@@ -432,6 +568,7 @@ void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext
               setRequestedMainView(screenNumber);
               mainRequestFlags |= (1u << REQUEST_MAIN_VIEW);
             }
+            scheduleRepeat(cfn, functionsContext, i);
             break;
 #endif
 #if defined(DEBUG)
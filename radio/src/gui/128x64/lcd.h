@@ -162,6 +162,15 @@ void drawTelemetryTopBar();
 
 
 void lcdClear();
+
+// Display pages (8 lines) changed since the previous call, one bit per
+// page, for the LCD drivers to only send those
+#define LCD_PAGES                      8
+#define LCD_PAGE_SIZE                  (DISPLAY_BUFFER_SIZE / LCD_PAGES)
+#define LCD_FULL_REFRESH_PERIOD        64
+uint8_t lcdGetChangedPages();
+// All pages are returned by the next lcdGetChangedPages() call
+void lcdInvalidatePages();
 void lcdDraw1bitBitmap(coord_t x, coord_t y, const unsigned char * img, uint8_t idx, LcdFlags att=0);
 inline void lcdDrawBitmap(coord_t x, coord_t y, const uint8_t * bitmap)
 {
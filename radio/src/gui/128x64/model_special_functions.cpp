@@ -38,6 +38,7 @@
 #define SD_LOGS_PERIOD_MIN      1     // 0.1s  fastest period 
 #define SD_LOGS_PERIOD_MAX      255   // 25.5s slowest period 
 #define SD_LOGS_PERIOD_DEFAULT  10    // 1s    default period for newly created SF 
+#define SD_LOGS_HIGH_RATE_MAX   9     // 90ms  slowest high rate period, 10ms fastest
 
 void onCustomFunctionsFileSelectionMenu(const char * result)
 {
@@ -469,6 +470,17 @@ void menuSpecialFunctions(event_t event, CustomFunctionData * functions, CustomF
               if (active) CFN_PLAY_REPEAT(cfn) = checkIncDec(event, CFN_PLAY_REPEAT(cfn)==CFN_PLAY_REPEAT_NOSTART?-1:CFN_PLAY_REPEAT(cfn), -1, 60/CFN_PLAY_REPEAT_MUL, eeFlags);
             }
           }
+#if defined(SDCARD)
+          else if (func == FUNC_LOGS) {
+            if (CFN_LOGS_HIGH_RATE(cfn) == 0) {
+              lcdDrawChar(MODEL_SPECIAL_FUNC_4TH_COLUMN_ONOFF+3, y, '-', attr);
+            }
+            else {
+              lcdDrawNumber(MODEL_SPECIAL_FUNC_4TH_COLUMN+2+FW, y, CFN_LOGS_HIGH_RATE(cfn)*10, RIGHT | attr);
+            }
+            if (active) CFN_LOGS_HIGH_RATE(cfn) = checkIncDec(event, CFN_LOGS_HIGH_RATE(cfn), 0, SD_LOGS_HIGH_RATE_MAX, eeFlags);
+          }
+#endif
           else if (attr) {
             repeatLastCursorMove(event);
           }
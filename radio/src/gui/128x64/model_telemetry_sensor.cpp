@@ -38,6 +38,7 @@ enum SensorFields {
   SENSOR_FIELD_FILTER,
   SENSOR_FIELD_PERSISTENT,
   SENSOR_FIELD_LOGS,
+  SENSOR_FIELD_LOGS_HIGH_RATE,
   SENSOR_FIELD_MAX
 };
 
@@ -65,7 +66,8 @@ void menuModelSensor(event_t event)
     (sensor->isConfigurable() ? (uint8_t)0 : HIDDEN_ROW), // Only positive
     (sensor->isConfigurable() ? (uint8_t)0 : HIDDEN_ROW), // Filter
     (sensor->type == TELEM_TYPE_CALCULATED ? (uint8_t)0 : HIDDEN_ROW), // Persistent
-    0 // Logs
+    0, // Logs
+    (sensor->logs ? (uint8_t)0 : HIDDEN_ROW) // Logs high rate
   });
 
   lcdDrawNumber(PSIZE(TR_MENUSENSOR)*FW+1, 0, s_currIdx+1, INVERS|LEFT);
@@ -304,6 +306,10 @@ void menuModelSensor(event_t event)
           logsClose();
         }
         break;
+
+      case SENSOR_FIELD_LOGS_HIGH_RATE:
+        sensor->logsHighRate = editCheckBox(sensor->logsHighRate, SENSOR_2ND_COLUMN, y, STR_LOGS_HIGH_RATE, attr, event);
+        break;
     }
   }
 }
@@ -22,13 +22,22 @@
 #include "opentx.h"
 #include "tasks.h"
 #include "mixer_scheduler.h"
+#include "bin_allocator.h"
 
 #include "hal/adc_driver.h"
 
+#if defined(STORAGE_MODELSLIST)
+#include "storage/modelslist.h"
+#endif
+
 #if defined(BLUETOOTH)
   #include "bluetooth_driver.h"
 #endif
 
+#if defined(LUA)
+  #include "lua/lua_cache.h"
+#endif
+
 #define STATS_1ST_COLUMN               1
 #define STATS_2ND_COLUMN               7*FW+FW/2
 #define STATS_3RD_COLUMN               14*FW+FW/2
@@ -259,6 +268,41 @@ void menuStatisticsDebug2(event_t event)
   y += FH;
 #endif
 
+#if defined(LUA) && defined(USE_BIN_ALLOCATOR)
+  // maximum number of Lua bins used, for each bin size
+  lcdDrawTextAlignedLeft(y, "Lua bins");
+  lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, slots1.stats().highWater, LEFT);
+  lcdDrawText(lcdLastRightPos, y, "/");
+  lcdDrawNumber(lcdLastRightPos, y, slots2.stats().highWater, LEFT);
+  y += FH;
+#endif
+
+#if defined(STORAGE_MODELSLIST)
+  lcdDrawTextAlignedLeft(y, STR_MODELS);
+  lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, modelslist.getLoadDuration(), LEFT);
+  lcdDrawText(lcdLastRightPos, y, STR_MS);
+  y += FH;
+#endif
+
+#if defined(LUA)
+  // scripts load time, cached / all loads, and the slowest script
+  const LuaCacheStats & luaStats = luaCache.getStats();
+  lcdDrawTextAlignedLeft(y, STR_LUA_LOAD_LABEL);
+  lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, luaStats.loadDuration / 1000, LEFT);
+  lcdDrawText(lcdLastRightPos, y, STR_MS);
+  lcdDrawNumber(lcdLastRightPos + FW, y, luaStats.noHits, LEFT);
+  lcdDrawText(lcdLastRightPos, y, "/");
+  lcdDrawNumber(lcdLastRightPos, y, luaStats.noLoads, LEFT);
+  y += FH;
+  const LuaScriptLoadStats * slowest = luaCache.getSlowestScript();
+  if (slowest) {
+    lcdDrawSizedText(FW, y, slowest->name, 9);
+    lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, slowest->lastDuration / 100, LEFT | PREC1);
+    lcdDrawText(lcdLastRightPos, y, STR_MS);
+    y += FH;
+  }
+#endif
+
   lcdDrawText(LCD_W/2, 7*FH+1, STR_MENUTORESET, CENTERED);
   lcdInvertLastLine();
 }
@@ -51,6 +51,48 @@ void lcdClear()
   memset(displayBuf, 0, DISPLAY_BUFFER_SIZE * sizeof(pixel_t));
 }
 
+// Checksums of the display pages (8 lines each) as last sent to the
+// LCD. The menus draw the whole screen again before each refresh, so
+// the pages which changed are found by comparing their contents with
+// what was sent rather than by tracking the writes to displayBuf.
+static uint32_t lcdPagesChecksum[LCD_PAGES];
+static uint8_t lcdFullRefreshCounter = 0;
+
+static_assert(LCD_PAGE_SIZE % 4 == 0, "Bad display page size");
+
+static uint32_t lcdPageChecksum(const pixel_t * p)
+{
+  // FNV-1a, 4 bytes at a time
+  uint32_t sum = 2166136261u;
+  for (const pixel_t * end = p + LCD_PAGE_SIZE; p < end; p += 4) {
+    sum = (sum ^ (p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24))) * 16777619u;
+  }
+  return sum;
+}
+
+uint8_t lcdGetChangedPages()
+{
+  // all pages are sent from time to time, should the LCD have lost its
+  // content (ESD, brown-out)
+  bool all = (lcdFullRefreshCounter == 0);
+  lcdFullRefreshCounter = (lcdFullRefreshCounter + 1) % LCD_FULL_REFRESH_PERIOD;
+
+  uint8_t pages = 0;
+  for (uint8_t page = 0; page < LCD_PAGES; page++) {
+    uint32_t sum = lcdPageChecksum(&displayBuf[page * LCD_PAGE_SIZE]);
+    if (all || sum != lcdPagesChecksum[page]) {
+      lcdPagesChecksum[page] = sum;
+      pages |= 1 << page;
+    }
+  }
+  return pages;
+}
+
+void lcdInvalidatePages()
+{
+  lcdFullRefreshCounter = 0;
+}
+
 coord_t lcdLastRightPos;
 coord_t lcdLastLeftPos;
 coord_t lcdNextPos;
@@ -163,6 +163,15 @@ void lcdDrawRleBitmap(coord_t x, coord_t y, const uint8_t * img, coord_t offset=
 
 void lcdClear();
 
+// Display pages (8 lines) changed since the previous call, one bit per
+// page, for the LCD drivers to only send those
+#define LCD_PAGES                      8
+#define LCD_PAGE_SIZE                  (DISPLAY_BUFFER_SIZE / LCD_PAGES)
+#define LCD_FULL_REFRESH_PERIOD        64
+uint8_t lcdGetChangedPages();
+// All pages are returned by the next lcdGetChangedPages() call
+void lcdInvalidatePages();
+
 uint8_t * lcdLoadBitmap(uint8_t * dest, const char * filename, uint16_t width, uint16_t height);
 
 #if defined(BOOT)
@@ -38,6 +38,7 @@ enum SensorFields {
   SENSOR_FIELD_FILTER,
   SENSOR_FIELD_PERSISTENT,
   SENSOR_FIELD_LOGS,
+  SENSOR_FIELD_LOGS_HIGH_RATE,
   SENSOR_FIELD_MAX
 };
 
@@ -54,6 +55,7 @@ enum SensorFields {
 #define SENSOR_ONLYPOS_ROWS    (sensor->isConfigurable() ? (uint8_t)0 : HIDDEN_ROW)
 #define SENSOR_FILTER_ROWS     (sensor->isConfigurable() ? (uint8_t)0 : HIDDEN_ROW)
 #define SENSOR_PERSISTENT_ROWS (sensor->type == TELEM_TYPE_CALCULATED ? (uint8_t)0 : HIDDEN_ROW)
+#define SENSOR_HIGH_RATE_ROWS  (sensor->logs ? (uint8_t)0 : HIDDEN_ROW)
 
 void menuModelSensor(event_t event)
 {
@@ -80,7 +82,8 @@ void menuModelSensor(event_t event)
     SENSOR_ONLYPOS_ROWS,
     SENSOR_FILTER_ROWS,
     SENSOR_PERSISTENT_ROWS,
-    0  // Logs
+    0, // Logs
+    SENSOR_HIGH_RATE_ROWS
   });
 
   for (uint8_t i=0; i<NUM_BODY_LINES; i++) {
@@ -319,6 +322,10 @@ void menuModelSensor(event_t event)
         }
         break;
 
+      case SENSOR_FIELD_LOGS_HIGH_RATE:
+        sensor->logsHighRate = editCheckBox(sensor->logsHighRate, SENSOR_2ND_COLUMN, y, STR_LOGS_HIGH_RATE, attr, event);
+        break;
+
     }
   }
 }
@@ -22,6 +22,7 @@
 #include "hal/adc_driver.h"
 #include "opentx.h"
 #include "tasks.h"
+#include "bin_allocator.h"
 
 #define STATS_1ST_COLUMN               FW/2
 #define STATS_2ND_COLUMN               12*FW+FW/2
@@ -181,6 +182,18 @@ void menuStatisticsDebug(event_t event)
   y += FH;
 #endif
 
+#if defined(LUA) && defined(USE_BIN_ALLOCATOR)
+  // Lua bins: used / maximum used, for each bin size
+  lcdDrawTextAlignedLeft(y, "Lua bins");
+  lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, slots1.size(), LEFT);
+  lcdDrawText(lcdLastRightPos, y, "/");
+  lcdDrawNumber(lcdLastRightPos, y, slots1.stats().highWater, LEFT);
+  lcdDrawNumber(lcdLastRightPos+FW, y, slots2.size(), LEFT);
+  lcdDrawText(lcdLastRightPos, y, "/");
+  lcdDrawNumber(lcdLastRightPos, y, slots2.stats().highWater, LEFT);
+  y += FH;
+#endif
+
   lcdDrawTextAlignedLeft(y, STR_TMIXMAXMS);
   lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, DURATION_MS_PREC2(maxMixerDuration), PREC2|LEFT);
   lcdDrawText(lcdLastRightPos, y, STR_MS);
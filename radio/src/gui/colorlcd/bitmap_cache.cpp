@@ -0,0 +1,333 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <memory>
+
+#include "bitmap_cache.h"
+#include "definitions.h"
+#include "opentx_helpers.h"
+#include "sdcard.h"
+#include "debug.h"
+
+#if defined(BITMAP_THUMBNAILS)
+#include "libopenui/thirdparty/lz4/lz4.h"
+#endif
+
+BitmapCache bitmapCache;
+
+static bool getModificationTime(const char * filename, uint32_t & mtime)
+{
+  FILINFO info;
+  if (f_stat(filename, &info) != FR_OK) return false;
+  mtime = ((uint32_t)info.fdate << 16) | info.ftime;
+  return true;
+}
+
+static BitmapBuffer * scaleBitmap(const BitmapBuffer * source, coord_t w,
+                                  coord_t h)
+{
+  float scale = min<float>(float(w) / source->width(),
+                           float(h) / source->height());
+  coord_t scaledw = max<coord_t>(1, source->width() * scale);
+  coord_t scaledh = max<coord_t>(1, source->height() * scale);
+
+  // opaque images are kept in the LCD format, to be copied as is
+  uint8_t format =
+      source->getFormat() == BMP_RGB565 ? BMP_RGB565 : BMP_ARGB4444;
+  BitmapBuffer * bitmap = new BitmapBuffer(format, scaledw, scaledh);
+  bitmap->clear();
+  bitmap->drawScaledBitmap(source, 0, 0, scaledw, scaledh);
+  return bitmap;
+}
+
+#if defined(BITMAP_THUMBNAILS)
+
+#define THUMBNAIL_MAGIC  "THB1"
+
+// Followed by the width, height and data length (as the LZ4 bitmaps
+// built into the firmware), and the pixels
+PACK(struct ThumbnailHeader {
+  char magic[4];
+  uint32_t mtime;         // of the source image
+  uint16_t boxWidth;      // requested size
+  uint16_t boxHeight;
+  uint8_t format;
+  uint8_t compressed;
+  uint16_t spare;
+});
+
+PACK(struct ThumbnailSize {
+  uint16_t width;
+  uint16_t height;
+  uint32_t length;
+});
+
+static std::string getThumbnailPath(const char * filename, coord_t w,
+                                    coord_t h)
+{
+  return std::string(filename) + "." + std::to_string(w) + "x" +
+         std::to_string(h) + THUMBNAIL_EXT;
+}
+
+static BitmapBuffer * loadThumbnail(const char * filename, uint32_t mtime,
+                                    coord_t w, coord_t h)
+{
+  FIL file;
+  std::string path = getThumbnailPath(filename, w, h);
+  if (f_open(&file, path.c_str(), FA_OPEN_EXISTING | FA_READ) != FR_OK)
+    return nullptr;
+
+  BitmapBuffer * bitmap = nullptr;
+  ThumbnailHeader header;
+  ThumbnailSize size;
+  UINT read;
+  if (f_read(&file, &header, sizeof(header), &read) == FR_OK &&
+      read == sizeof(header) && f_read(&file, &size, sizeof(size), &read) == FR_OK &&
+      read == sizeof(size) && !memcmp(header.magic, THUMBNAIL_MAGIC, 4) &&
+      header.mtime == mtime && header.boxWidth == w && header.boxHeight == h &&
+      (header.format == BMP_RGB565 || header.format == BMP_ARGB4444) &&
+      size.width > 0 && size.width <= w && size.height > 0 &&
+      size.height <= h) {
+    bitmap = new BitmapBuffer(header.format, size.width, size.height);
+    uint32_t pixelsSize = bitmap->getDataSize();
+    bool valid = false;
+    if (header.compressed) {
+      char * compressed = (char *)malloc(size.length);
+      if (compressed && f_read(&file, compressed, size.length, &read) == FR_OK &&
+          read == size.length) {
+        valid = LZ4_decompress_safe(compressed, (char *)bitmap->getData(),
+                                    size.length, pixelsSize) == (int)pixelsSize;
+      }
+      free(compressed);
+    } else if (size.length == pixelsSize) {
+      valid = f_read(&file, bitmap->getData(), pixelsSize, &read) == FR_OK &&
+              read == pixelsSize;
+    }
+    if (!valid) {
+      delete bitmap;
+      bitmap = nullptr;
+    }
+  }
+
+  f_close(&file);
+  return bitmap;
+}
+
+static bool saveThumbnail(const char * filename, uint32_t mtime, coord_t w,
+                          coord_t h, const BitmapBuffer * bitmap)
+{
+  ThumbnailHeader header = {};
+  memcpy(header.magic, THUMBNAIL_MAGIC, 4);
+  header.mtime = mtime;
+  header.boxWidth = w;
+  header.boxHeight = h;
+  header.format = bitmap->getFormat();
+
+  ThumbnailSize size;
+  size.width = bitmap->width();
+  size.height = bitmap->height();
+  size.length = bitmap->getDataSize();
+  const char * data = (const char *)bitmap->getData();
+
+  // the LZ4 state is too large for the UI task stack
+  int bound = LZ4_compressBound(size.length);
+  void * state = malloc(LZ4_sizeofState());
+  char * compressed = (char *)malloc(bound);
+  if (state && compressed) {
+    int length = LZ4_compress_fast_extState(state, data, compressed,
+                                            size.length, bound, 1);
+    if (length > 0 && (uint32_t)length < size.length) {
+      header.compressed = 1;
+      size.length = length;
+      data = compressed;
+    }
+  }
+  free(state);
+
+  FIL file;
+  bool ok = false;
+  std::string path = getThumbnailPath(filename, w, h);
+  if (f_open(&file, path.c_str(), FA_CREATE_ALWAYS | FA_WRITE) == FR_OK) {
+    UINT written;
+    ok = f_write(&file, &header, sizeof(header), &written) == FR_OK &&
+         written == sizeof(header) &&
+         f_write(&file, &size, sizeof(size), &written) == FR_OK &&
+         written == sizeof(size) &&
+         f_write(&file, data, size.length, &written) == FR_OK &&
+         written == size.length;
+    f_close(&file);
+    if (!ok) {
+      TRACE("BitmapCache: could not write %s", path.c_str());
+      f_unlink(path.c_str());
+    }
+  }
+
+  free(compressed);
+  return ok;
+}
+#endif
+
+BitmapCacheEntry * BitmapCache::find(const char * filename, uint32_t mtime,
+                                     uint8_t format, coord_t w, coord_t h)
+{
+  for (auto & entry : entries) {
+    if (entry.mtime == mtime && entry.format == format && entry.width == w &&
+        entry.height == h && entry.filename == filename) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+const BitmapBuffer * BitmapCache::acquire(const char * filename,
+                                          BitmapFormats fmt, coord_t w,
+                                          coord_t h)
+{
+  uint32_t mtime;
+  if (!getModificationTime(filename, mtime)) return nullptr;
+
+  BitmapCacheEntry * entry = find(filename, mtime, fmt, w, h);
+  if (entry) {
+    ++stats.noHits;
+  } else {
+    ++stats.noMisses;
+
+    BitmapBuffer * bitmap = nullptr;
+    if (w > 0 && h > 0) {
+#if defined(BITMAP_THUMBNAILS)
+      bitmap = loadThumbnail(filename, mtime, w, h);
+      if (bitmap) ++stats.noThumbnailLoads;
+#endif
+      if (!bitmap) {
+        // the full size image is only kept when already cached
+        const BitmapBuffer * source = nullptr;
+        BitmapCacheEntry * original = find(filename, mtime, fmt, 0, 0);
+        std::unique_ptr<BitmapBuffer> decoded;
+        if (original) {
+          source = original->bitmap;
+        } else {
+          decoded.reset(BitmapBuffer::loadBitmap(filename, fmt));
+          source = decoded.get();
+        }
+        if (source) {
+          bitmap = scaleBitmap(source, w, h);
+#if defined(BITMAP_THUMBNAILS)
+          if (saveThumbnail(filename, mtime, w, h, bitmap))
+            ++stats.noThumbnailSaves;
+#endif
+        }
+      }
+    } else {
+      bitmap = BitmapBuffer::loadBitmap(filename, fmt);
+    }
+    if (!bitmap) return nullptr;
+
+    insert(filename, mtime, fmt, w, h, bitmap);
+    entry = &entries.back();
+  }
+
+  entry->refCount++;
+  entry->lastUse = ++useCounter;
+  return entry->bitmap;
+}
+
+void BitmapCache::insert(const char * filename, uint32_t mtime,
+                         uint8_t format, coord_t w, coord_t h,
+                         BitmapBuffer * bitmap)
+{
+  // older versions of the file won't be requested anymore
+  for (auto it = entries.begin(); it != entries.end();) {
+    if (it->refCount == 0 && it->mtime != mtime && it->filename == filename) {
+      stats.usedBytes -= it->bitmap->getDataSize();
+      delete it->bitmap;
+      it = entries.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  evict(bitmap->getDataSize());
+
+  entries.push_back({filename, mtime, format, w, h, bitmap, 0, 0});
+  stats.usedBytes += bitmap->getDataSize();
+}
+
+void BitmapCache::evict(uint32_t needed)
+{
+  // referenced bitmaps would be allocated anyway, and don't count
+  uint32_t unused = 0;
+  for (const auto & entry : entries) {
+    if (entry.refCount == 0) unused += entry.bitmap->getDataSize();
+  }
+
+  while (unused + needed > BITMAP_CACHE_SIZE) {
+    auto victim = entries.end();
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+      if (it->refCount == 0 &&
+          (victim == entries.end() ||
+           (int32_t)(it->lastUse - victim->lastUse) < 0)) {
+        victim = it;
+      }
+    }
+    if (victim == entries.end()) break;
+
+    uint32_t size = victim->bitmap->getDataSize();
+    TRACE("BitmapCache: evict %s (%u)", victim->filename.c_str(), size);
+    unused -= size;
+    stats.usedBytes -= size;
+    ++stats.noEvictions;
+    delete victim->bitmap;
+    entries.erase(victim);
+  }
+}
+
+bool BitmapCache::release(const BitmapBuffer * bitmap)
+{
+  if (!bitmap) return true;
+
+  for (auto & entry : entries) {
+    if (entry.bitmap == bitmap) {
+      if (entry.refCount > 0) entry.refCount--;
+      if (entry.refCount == 0) evict(0);
+      return true;
+    }
+  }
+  return false;
+}
+
+void BitmapCache::clear()
+{
+  for (auto it = entries.begin(); it != entries.end();) {
+    if (it->refCount == 0) {
+      stats.usedBytes -= it->bitmap->getDataSize();
+      delete it->bitmap;
+      it = entries.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+int BitmapCache::getHitRate() const
+{
+  uint32_t all = stats.noHits + stats.noMisses;
+  return all ? (stats.noHits * 1000) / all : 0;
+}
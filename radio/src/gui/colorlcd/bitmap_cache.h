@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "bitmapbuffer.h"
+
+// tunable parameters
+#define BITMAP_CACHE_SIZE    (1024 * 1024)  // bytes of unused decoded bitmaps
+#define BITMAP_THUMBNAILS                   // scaled images saved on the SD card
+
+struct BitmapCacheStats
+{
+  uint32_t noHits;
+  uint32_t noMisses;
+  uint32_t noEvictions;
+  uint32_t noThumbnailLoads;
+  uint32_t noThumbnailSaves;
+  uint32_t usedBytes;
+};
+
+struct BitmapCacheEntry
+{
+  std::string filename;
+  uint32_t mtime;          // FatFs date and time of the file
+  uint8_t format;
+  coord_t width;           // 0 when not scaled
+  coord_t height;
+  BitmapBuffer * bitmap;
+  uint16_t refCount;
+  uint32_t lastUse;
+};
+
+// Decoded images (model bitmaps, Lua Bitmap.open()), shared by the
+// widgets, the model select page and the Lua scripts:
+// - entries are keyed by path, modification time, format and scaled size,
+//   so that an image edited on the SD card is decoded again
+// - a bitmap is referenced until release() is called and must not be
+//   modified
+// - scaled images are saved next to the source image (THUMBNAIL_EXT
+//   file, RGB565 when the image is opaque, LZ4 compressed when smaller),
+//   and read back without decoding nor scaling while the source
+//   modification time is unchanged
+// - the least recently used unreferenced entries are evicted when they
+//   use more than BITMAP_CACHE_SIZE bytes
+//
+// The cache is only accessed from the UI task (which also runs Lua).
+class BitmapCache
+{
+ public:
+  // Returns the decoded image, or nullptr when the file can't be loaded.
+  // When w x h is given, the image is scaled to fit in (the ratio being
+  // kept) and should be drawn centered.
+  const BitmapBuffer * acquire(const char * filename,
+                               BitmapFormats fmt = BMP_INVALID,
+                               coord_t w = 0, coord_t h = 0);
+
+  // Returns false when the bitmap doesn't come from the cache
+  bool release(const BitmapBuffer * bitmap);
+
+  // Drops the unreferenced entries
+  void clear();
+
+  const BitmapCacheStats & getStats() const { return stats; }
+  int getHitRate() const;
+
+ protected:
+  std::vector<BitmapCacheEntry> entries;
+  uint32_t useCounter = 0;
+  BitmapCacheStats stats = {};
+
+  BitmapCacheEntry * find(const char * filename, uint32_t mtime,
+                          uint8_t format, coord_t w, coord_t h);
+  void insert(const char * filename, uint32_t mtime, uint8_t format,
+              coord_t w, coord_t h, BitmapBuffer * bitmap);
+  void evict(uint32_t needed);
+};
+
+extern BitmapCache bitmapCache;
@@ -21,6 +21,8 @@
 
 #include "model_select.h"
 
+#include "bitmap_cache.h"
+
 #include "libopenui.h"
 #include "menu_model.h"
 #include "menu_radio.h"
@@ -116,14 +118,16 @@ class ModelButton : public Button
 
     if (modelLayouts[layout].hsaImage) {
       GET_FILENAME(filename, BITMAPS_PATH, modelCell->modelBitmap, "");
-      const BitmapBuffer *bitmap = BitmapBuffer::loadBitmap(filename);
+      const BitmapBuffer *bitmap =
+          bitmapCache.acquire(filename, BMP_INVALID, w, h);
 
       if (bitmap) {
         buffer = new BitmapBuffer(BMP_RGB565, w, h);
         if (buffer) {
           buffer->clear(bg_color);
-          buffer->drawScaledBitmap(bitmap, 0, 0, w, h);
-          delete bitmap;
+          buffer->drawBitmap((w - bitmap->width()) / 2,
+                             (h - bitmap->height()) / 2, bitmap);
+          bitmapCache.release(bitmap);
 
           lv_obj_t *bm = lv_canvas_create(lvobj);
           lv_obj_center(bm);
@@ -402,6 +402,7 @@ class SensorEditWindow : public Page {
       P_ONLYPOS,
       P_FILTER,
       P_PERSISTENT,
+      P_LOGS_HIGH_RATE,
       P_COUNT,
     };
 
@@ -539,6 +540,10 @@ class SensorEditWindow : public Page {
       if (sensor->type == TELEM_TYPE_CALCULATED) {
         lv_obj_clear_flag(paramLines[P_PERSISTENT]->getLvObj(), LV_OBJ_FLAG_HIDDEN);
       }
+
+      if (sensor->logs) {
+        lv_obj_clear_flag(paramLines[P_LOGS_HIGH_RATE]->getLvObj(), LV_OBJ_FLAG_HIDDEN);
+      }
     }
 
     void buildBody(FormWindow * window)
@@ -732,8 +737,13 @@ class SensorEditWindow : public Page {
         sensor->logs = newValue;
         logsClose();
         SET_DIRTY();
+        updateSensorParameters();
       });
 
+      paramLines[P_LOGS_HIGH_RATE] = form->newLine(&grid);
+      new StaticText(paramLines[P_LOGS_HIGH_RATE], rect_t{}, STR_LOGS_HIGH_RATE, 0, COLOR_THEME_PRIMARY1);
+      new ToggleSwitch(paramLines[P_LOGS_HIGH_RATE], rect_t{}, GET_SET_DEFAULT(sensor->logsHighRate));
+
       updateSensorParameters();
     }
 };
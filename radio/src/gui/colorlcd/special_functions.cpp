@@ -244,6 +244,16 @@ class SpecialFunctionEditPage : public Page
             [=](int32_t value) {
               return formatNumberAsString(CFN_PARAM(cfn), PREC1, 0, nullptr, "s");
             });
+        line = specialFunctionOneWindow->newLine(&grid);
+
+        new StaticText(line, rect_t{}, STR_LOGS_HIGH_RATE, 0, COLOR_THEME_PRIMARY1);
+        auto highRate = new NumberEdit(line, rect_t{}, 0, SD_LOGS_HIGH_RATE_MAX,
+                                       GET_SET_DEFAULT(CFN_LOGS_HIGH_RATE(cfn)));
+        highRate->setDisplayHandler(
+            [=](int32_t value) {
+              if (value == 0) return std::string(STR_OFF);
+              return formatNumberAsString(value * 10, 0, 0, nullptr, "ms");
+            });
         break;
       }
 
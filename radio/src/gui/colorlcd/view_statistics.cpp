@@ -23,10 +23,19 @@
 
 #include "opentx.h"
 #include "draw_functions.h"
+#include "storage/modelslist.h"
 
 #include "tasks.h"
 #include "tasks/mixer_task.h"
 
+#if defined(DISK_CACHE)
+  #include "disk_cache.h"
+#endif
+
+#if defined(LUA)
+  #include "lua/lua_cache.h"
+#endif
+
 static const lv_coord_t col_dsc[] = {LV_GRID_FR(1), LV_GRID_FR(1),
                                      LV_GRID_FR(1), LV_GRID_FR(1),
                                      LV_GRID_TEMPLATE_LAST};
@@ -268,6 +277,57 @@ void DebugViewPage::build(FormWindow* window)
       line, rect_t{}, [] { return availableMemory(); }, COLOR_THEME_PRIMARY1, 
       nullptr, pad_STR_BYTES.c_str());
 
+  line = form->newLine(&grid);
+  line->padAll(2);
+
+  // Models list load time
+  new StaticText(line, rect_t{}, STR_MODELS, 0, COLOR_THEME_PRIMARY1);
+  new DynamicNumber<uint32_t>(
+      line, rect_t{}, [] { return modelslist.getLoadDuration(); },
+      COLOR_THEME_PRIMARY1, nullptr, pad_STR_MS.c_str());
+
+#if defined(LUA)
+  line = form->newLine(&grid);
+  line->padAll(2);
+
+  // Lua scripts load time, cached / all loads
+  new StaticText(line, rect_t{}, STR_LUA_LOAD_LABEL, 0, COLOR_THEME_PRIMARY1);
+  new DynamicText(
+      line, rect_t{},
+      [] {
+        const LuaCacheStats& stats = luaCache.getStats();
+        char s[32];
+        snprintf(s, sizeof(s), "%u%s  %u/%u",
+                 (unsigned)(stats.loadDuration / 1000), STR_MS,
+                 (unsigned)stats.noHits, (unsigned)stats.noLoads);
+        return std::string(s);
+      },
+      COLOR_THEME_PRIMARY1);
+
+  // and the last / slowest load of each script, 'c' when from the cache
+  for (uint8_t i = 0; i < luaCache.getStats().scriptsCount; i++) {
+    line = form->newLine(&grid);
+    line->padAll(2);
+    line->padLeft(10);
+    new StaticText(line, rect_t{}, luaCache.getStats().scripts[i].name, 0,
+                   COLOR_THEME_PRIMARY1);
+    new DynamicText(
+        line, rect_t{},
+        [=] {
+          const LuaScriptLoadStats& script = luaCache.getStats().scripts[i];
+          char s[32];
+          snprintf(s, sizeof(s), "%u.%u%s%s  %u.%u%s",
+                   (unsigned)(script.lastDuration / 1000),
+                   (unsigned)(script.lastDuration / 100 % 10), STR_MS,
+                   script.cached ? " c" : "",
+                   (unsigned)(script.maxDuration / 1000),
+                   (unsigned)(script.maxDuration / 100 % 10), STR_MS);
+          return std::string(s);
+        },
+        COLOR_THEME_PRIMARY1);
+  }
+#endif
+
 #if defined(LUA)
   line = form->newLine(&grid);
   line->padAll(2);
@@ -342,6 +402,27 @@ void DebugViewPage::build(FormWindow* window)
       [] { return audioStack.available(); }, COLOR_THEME_PRIMARY1,
       STR_STACK_AUDIO, nullptr);
 
+#if defined(DISK_CACHE)
+  line = form->newLine(&grid);
+  line->padAll(2);
+
+  // SD card cache
+  new StaticText(line, rect_t{}, STR_DISK_CACHE_LABEL, 0, COLOR_THEME_PRIMARY1);
+#if LCD_H > LCD_W
+  line = form->newLine(&grid2);
+  line->padAll(0);
+  line->padLeft(10);
+#endif
+  new DebugInfoNumber<uint32_t>(
+      line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
+      [] { return diskCache.getHitRate() / 10; }, COLOR_THEME_PRIMARY1,
+      STR_DISK_CACHE_HITS, nullptr);
+  new DebugInfoNumber<uint32_t>(
+      line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
+      [] { return diskCache.getStats().noPrefetches; }, COLOR_THEME_PRIMARY1,
+      STR_DISK_CACHE_READAHEAD, nullptr);
+#endif
+
 #if defined(DEBUG_LATENCY)
   line = form->newLine(&grid2);
   line->padAll(2);
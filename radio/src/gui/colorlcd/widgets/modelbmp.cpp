@@ -21,8 +21,7 @@
 
 #include "opentx.h"
 #include "widgets_container_impl.h"
-
-#include <memory>
+#include "bitmap_cache.h"
 
 class ModelBitmapWidget: public Widget
 {
@@ -33,6 +32,11 @@ class ModelBitmapWidget: public Widget
       loadBitmap();
     }
 
+    ~ModelBitmapWidget()
+    {
+      bitmapCache.release(bitmap);
+    }
+
     void refresh(BitmapBuffer * dc) override
     {
       std::string filename = std::string(g_model.header.bitmap);
@@ -53,9 +57,8 @@ class ModelBitmapWidget: public Widget
         dc->drawSolidFilledRect(0, 0, width(), height(), fillColour);
       }
 
-      if (buffer &&
-          ((buffer->width() != width()) || (buffer->height() != height()) ||
-           (deps_hash != getHash()))) {
+      if ((bitmapWidth != width()) || (bitmapHeight != getBitmapHeight()) ||
+          (deps_hash != getHash())) {
 
         loadBitmap();
         deps_hash = getHash();
@@ -64,16 +67,16 @@ class ModelBitmapWidget: public Widget
       // big space to draw
       if (rect.h >= 96 && rect.w >= 120) {
 
-        if (!filename.empty() && buffer) {
-          dc->drawBitmap(0, 38, buffer.get());
+        if (!filename.empty() && bitmap) {
+          drawModelBitmap(dc, 38);
         }
 
         dc->drawSizedText(5, 5, g_model.header.name, LEN_MODEL_NAME, fontSize | fontColor);
       }
       // smaller space to draw
       else {
-        if (!filename.empty() && buffer) {
-          dc->drawBitmap(0, 0, buffer.get());
+        if (!filename.empty() && bitmap) {
+          drawModelBitmap(dc, 0);
         }
         else {
           dc->drawSizedText(0, 0, g_model.header.name, LEN_MODEL_NAME, fontSize | fontColor);
@@ -92,7 +95,10 @@ class ModelBitmapWidget: public Widget
     static const ZoneOption options[];
 
   protected:
-    std::unique_ptr<BitmapBuffer> buffer;
+    // scaled model image, shared with the model select page
+    const BitmapBuffer * bitmap = nullptr;
+    coord_t bitmapWidth = 0;
+    coord_t bitmapHeight = 0;
     uint32_t deps_hash = 0;
 
     uint32_t getHash()
@@ -100,27 +106,32 @@ class ModelBitmapWidget: public Widget
       return hash(g_model.header.bitmap, LEN_BITMAP_NAME);
     }
   
+    coord_t getBitmapHeight()
+    {
+      return (rect.h >= 96 && rect.w >= 120) ? height() - 38 : height();
+    }
+
+    void drawModelBitmap(BitmapBuffer * dc, coord_t y)
+    {
+      dc->drawBitmap((bitmapWidth - bitmap->width()) / 2,
+                     y + (bitmapHeight - bitmap->height()) / 2, bitmap);
+    }
+
     void loadBitmap()
     {
       std::string filename = std::string(g_model.header.bitmap);
       std::string fullpath = std::string(BITMAPS_PATH PATH_SEPARATOR) + filename;
 
-      if (!buffer || (buffer->width() != width()) || (buffer->height() != height())) {
-        buffer.reset(new BitmapBuffer(BMP_ARGB4444, width(), height()));
-      }
+      bitmapCache.release(bitmap);
+      bitmap = nullptr;
+      bitmapWidth = width();
+      bitmapHeight = getBitmapHeight();
 
-      buffer->clear();
       if (!filename.empty()) {
-        std::unique_ptr<BitmapBuffer> bitmap(BitmapBuffer::loadBitmap(fullpath.c_str()));
+        bitmap = bitmapCache.acquire(fullpath.c_str(), BMP_INVALID,
+                                     bitmapWidth, bitmapHeight);
         if (!bitmap) {
           TRACE("could not load bitmap '%s'", filename.c_str());
-          return;
-        }
-
-        if (rect.h >= 96 && rect.w >= 120) {
-          buffer->drawScaledBitmap(bitmap.get(), 0, 0, width(), height() - 38);
-        } else {
-          buffer->drawScaledBitmap(bitmap.get(), 0, 0, width(), height());
         }
       }
     }
@@ -91,6 +91,28 @@ uint8_t fatfsGetLun(uint8_t pdrv)
   return _fatfs_drives[pdrv].lun;
 }
 
+bool fatfsTryLockDrive(uint8_t pdrv)
+{
+  if (pdrv >= _fatfs_n_drives) {
+    return false;
+  }
+
+#if FF_FS_REENTRANT != 0
+  return RTOS_TRYLOCK_MUTEX(_fatfs_drives[pdrv].mutex);
+#else
+  return true;
+#endif
+}
+
+void fatfsUnlockDrive(uint8_t pdrv)
+{
+#if FF_FS_REENTRANT != 0
+  if (pdrv < _fatfs_n_drives) {
+    RTOS_UNLOCK_MUTEX(_fatfs_drives[pdrv].mutex);
+  }
+#endif
+}
+
 #if FF_FS_REENTRANT != 0
 
 int ff_cre_syncobj(BYTE vol, FF_SYNC_t* mutex)
@@ -50,3 +50,8 @@ const diskio_driver_t* fatfsGetDriver(uint8_t pdrv);
 
 // returns a physical LUN or 0
 uint8_t fatfsGetLun(uint8_t pdrv);
+
+// non-blocking attempt at getting exclusive access to a drive,
+// as FatFs does for each file system operation
+bool fatfsTryLockDrive(uint8_t pdrv);
+void fatfsUnlockDrive(uint8_t pdrv);
@@ -56,9 +56,13 @@ struct etx_proto_driver_t {
     // Process input data byte (telemetry)
     void (*processData)(void* ctx, uint8_t data, uint8_t* buffer, uint8_t* len);
 
-    // Process input data byte (telemetry)
+    // Process input data frame (telemetry)
     void (*processFrame)(void* ctx, uint8_t* frame, uint8_t flen, uint8_t* buf, uint8_t* len);
 
+    // Process a chunk of input data (telemetry, optional:
+    // processData() is called for each byte otherwise)
+    void (*processBuffer)(void* ctx, const uint8_t* data, uint32_t len, uint8_t* buf, uint8_t* p_len);
+
     // Some module settings may have been modified
     void (*onConfigChange)(void* ctx);
 
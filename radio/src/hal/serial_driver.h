@@ -97,6 +97,8 @@ typedef struct {
   // Return the number of unread bytes
   int (*getBufferedBytes)(void* ctx);
 
+  // Fetch up to 'len' available bytes from internal buffer
+  // (returns the number of bytes fetched)
   int (*copyRxBuffer)(void* ctx, uint8_t* buf, uint32_t len);
 
   // Clear internal buffer
@@ -44,7 +44,7 @@
     .status = _STORAGE_DRIVER.status,
     .read = disk_cache_read,
     .write = disk_cache_write,
-    .ioctl = _STORAGE_DRIVER.ioctl,
+    .ioctl = disk_cache_ioctl,
   };
 #endif
 
@@ -67,6 +67,10 @@ void storageInit()
 
 void storageDeInit()
 {
+#if defined(DISK_CACHE)
+  // power off / USB mass storage: nothing may be left pending
+  diskCache.flush();
+#endif
   fatfsUnregisterDrivers();
 }
 
@@ -77,6 +81,17 @@ void storagePreMountHook()
 #endif
 }
 
+void storagePeriodicTasks()
+{
+#if defined(DISK_CACHE)
+  if (fatfsTryLockDrive(0)) {
+    diskCache.flushExpired();
+    diskCache.prefetch();
+    fatfsUnlockDrive(0);
+  }
+#endif
+}
+
 bool storageIsPresent()
 {
   return (_STORAGE_DRIVER.status(0) & STA_NODISK) == 0;
@@ -33,6 +33,11 @@ void storagePreMountHook();
 
 bool storageIsPresent();
 
+// Reads ahead the data requested by sequential reads and writes
+// the data delayed by the disk cache, if any
+// (does nothing if the storage is in use)
+void storagePeriodicTasks();
+
 #define SD_CARD_PRESENT() storageIsPresent()
 
 struct diskio_driver_t;
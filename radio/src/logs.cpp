@@ -22,6 +22,8 @@
 #include "opentx.h"
 #include "ff.h"
 
+#include <stdarg.h>
+
 #include "analogs.h"
 #include "switches.h"
 #include "hal/adc_driver.h"
@@ -34,8 +36,82 @@
 
 FIL g_oLogFile __DMA;
 uint8_t logDelay100ms;
+uint8_t logHighRate10ms;
 static tmr10ms_t lastLogTime = 0;
 
+// In high rate mode, one line is written every logHighRate10ms, but
+// the telemetry sensors which are not flagged 'high rate' are only
+// written every logDelay100ms, their cells being left empty otherwise
+static uint16_t logsDecimationCount = 0;
+
+static uint32_t getLoggingPeriod10ms()
+{
+  if (logHighRate10ms > 0 && logHighRate10ms < logDelay100ms * 10)
+    return logHighRate10ms;
+  return logDelay100ms * 10;
+}
+
+// Log lines are formatted into this buffer by logsWrite() (logging timer),
+// and written to the SD card by logsFlush() (menus task) in sector sized
+// chunks, so that the SD card latency does not delay the logging timer.
+// The file is also opened, and its header written, by logsFlush(): the
+// logging timer never calls FatFs.
+#define LOGS_SECTOR_SIZE      512
+#if defined(COLORLCD)
+  #define LOGS_BUFFER_SIZE    (4 * LOGS_SECTOR_SIZE)
+#else
+  #define LOGS_BUFFER_SIZE    (2 * LOGS_SECTOR_SIZE)
+#endif
+
+static char logsBuffer[LOGS_BUFFER_SIZE] __DMA;
+static volatile uint32_t logsBufferHead = 0;  // only written by logsWrite()
+static volatile uint32_t logsBufferTail = 0;  // only written by the menus task
+static volatile bool logsCloseRequest = false;
+static const char * logsError = nullptr;
+
+class LogsLine
+{
+  public:
+    LogsLine() : head(logsBufferHead) {}
+
+    void putc(char c)
+    {
+      if (head - logsBufferTail >= LOGS_BUFFER_SIZE) {
+        overflow = true;
+        return;
+      }
+      logsBuffer[head % LOGS_BUFFER_SIZE] = c;
+      head++;
+    }
+
+    void puts(const char * str)
+    {
+      while (*str) putc(*str++);
+    }
+
+    void printf(const char * format, ...) __attribute__((format(printf, 2, 3)))
+    {
+      char tmp[32];
+      va_list args;
+      va_start(args, format);
+      vsnprintf(tmp, sizeof(tmp), format, args);
+      va_end(args);
+      puts(tmp);
+    }
+
+    // Publish the line to logsFlush(), unless it did not fit
+    bool commit()
+    {
+      if (overflow) return false;
+      logsBufferHead = head;
+      return true;
+    }
+
+  protected:
+    uint32_t head;
+    bool overflow = false;
+};
+
 #if !defined(SIMU)
 #include <FreeRTOS/include/FreeRTOS.h>
 #include <FreeRTOS/include/timers.h>
@@ -59,7 +135,7 @@ void loggingTimerStart()
 {
   if (!loggingTimer) {
     loggingTimer =
-        xTimerCreateStatic("Logging", logDelay100ms*100 / RTOS_MS_PER_TICK, pdTRUE, (void*)0,
+        xTimerCreateStatic("Logging", getLoggingPeriod10ms()*10 / RTOS_MS_PER_TICK, pdTRUE, (void*)0,
                            loggingTimerCb, &loggingTimerBuffer);
   }
 
@@ -81,18 +157,19 @@ void loggingTimerStop()
 }
 
 void initLoggingTimer() {                                       // called cyclically by main.cpp:perMain()
-  static uint8_t logDelay100msOld = 0;
+  static uint32_t logPeriod10msOld = 0;
+  uint32_t logPeriod10ms = getLoggingPeriod10ms();
 
   if(loggingTimer == nullptr) {                                 // log Timer not running
     if(isFunctionActive(FUNCTION_LOGS) && logDelay100ms > 0) {  // if SF Logging is active and log rate is valid
       loggingTimerStart();                                      // start log timer
     }  
   } else {                                                      // log timer is already running
-    if(logDelay100msOld != logDelay100ms) {                     // if log rate was changed
-      logDelay100msOld = logDelay100ms;                         // memorize new log rate
+    if(logPeriod10msOld != logPeriod10ms) {                     // if log rate was changed
+      logPeriod10msOld = logPeriod10ms;                         // memorize new log rate
 
-      if(logDelay100ms > 0) {
-        if(xTimerChangePeriod( loggingTimer, logDelay100ms*100, 0 ) != pdPASS ) {  // and restart timer with new log rate
+      if(logPeriod10ms > 0) {
+        if(xTimerChangePeriod( loggingTimer, logPeriod10ms*10 / RTOS_MS_PER_TICK, 0 ) != pdPASS ) {  // and restart timer with new log rate
           /* The timer period could not be changed */
         }
       }
@@ -180,16 +257,86 @@ const char * logsOpen()
   return nullptr;
 }
 
+void logsFlush(bool all)
+{
+  if (!g_oLogFile.obj.fs) return;
+
+  uint32_t tail = logsBufferTail;
+  uint32_t used = logsBufferHead - tail;
+
+  while (used > 0) {
+    // stop on a sector boundary in the file, unless everything goes
+    uint32_t count = LOGS_SECTOR_SIZE - f_tell(&g_oLogFile) % LOGS_SECTOR_SIZE;
+    if (count > used) {
+      if (!all) break;
+      count = used;
+    }
+    uint32_t offset = tail % LOGS_BUFFER_SIZE;
+    count = min<uint32_t>(count, LOGS_BUFFER_SIZE - offset);
+
+    UINT written;
+    if (f_write(&g_oLogFile, &logsBuffer[offset], count, &written) != FR_OK ||
+        written != count) {
+      logsError = STR_SDCARD_ERROR;
+      POPUP_WARNING_ON_UI_TASK(STR_SDCARD_ERROR, nullptr, false);
+      logsBufferTail = logsBufferHead;
+      logsCloseRequest = true;
+      break;
+    }
+
+    tail += count;
+    used -= count;
+    logsBufferTail = tail;
+  }
+}
+
+void logsFlush()
+{
+  if (logsBufferHead != logsBufferTail) {
+    // check if file needs to be opened, and at every write cycle
+    // if the SD card is full
+    const char * result = sdIsFull() ? STR_SDCARD_FULL_EXT : nullptr;
+    if (!result && !g_oLogFile.obj.fs) {
+      result = logsOpen();
+    }
+
+    // SD card is full or file open failed: the lines are dropped, the
+    // file will be opened again with the next ones, and fail with the
+    // same error which will not trigger the warning popup again
+    if (result) {
+      if (result != logsError) {
+        logsError = result;
+        POPUP_WARNING_ON_UI_TASK(result, nullptr, false);
+      }
+      logsBufferTail = logsBufferHead;
+      logsCloseRequest = true;
+    }
+    else {
+      logsFlush(false);
+    }
+  }
+
+  if (logsCloseRequest) {
+    logsClose();
+  }
+}
+
 void logsClose()
 {
+  logsCloseRequest = false;
   if (g_oLogFile.obj.fs && sdMounted()) {
+    logsFlush(true);
     if (f_close(&g_oLogFile) != FR_OK) {
       // close failed, forget file
       g_oLogFile.obj.fs = 0;
     }
     lastLogTime = 0;
+    logsDecimationCount = 0;
   }
 
+  // the lines which could not be written (no SD card, write error) must
+  // not go to the next file, ahead of its header
+  logsBufferTail = logsBufferHead;
 }
 
 void writeHeader()
@@ -266,8 +413,6 @@ uint32_t getLogicalSwitchesStates(uint8_t first)
 
 void logsWrite()
 {
-  static const char * error_displayed = nullptr;
-
   if (!sdMounted()) {
     return;
   }
@@ -275,36 +420,29 @@ void logsWrite()
   if (isFunctionActive(FUNCTION_LOGS) && logDelay100ms > 0 && !usbPlugged()) {
     #if defined(SIMU) || !defined(RTCLOCK)
     tmr10ms_t tmr10ms = get_tmr10ms();                                        // tmr10ms works in 10ms increments
-    if (lastLogTime == 0 || (tmr10ms_t)(tmr10ms - lastLogTime) >= (tmr10ms_t)(logDelay100ms*10)-1) {
+    tmr10ms_t period10ms = getLoggingPeriod10ms();
+    if (period10ms > 2) period10ms -= 1;                                      // tolerate 10ms jitter on slow rates
+    if (lastLogTime == 0 || (tmr10ms_t)(tmr10ms - lastLogTime) >= period10ms) {
       lastLogTime = tmr10ms;
     #else
     {
     #endif
 
-      bool sdCardFull = sdIsFull();
-
-      // check if file needs to be opened
-      if (!g_oLogFile.obj.fs) {
-        const char *result = sdCardFull ? STR_SDCARD_FULL_EXT : logsOpen();
-
-        // SD card is full or file open failed
-        if (result) {
-          if (result != error_displayed) {
-            error_displayed = result;
-            POPUP_WARNING_ON_UI_TASK(result, nullptr, false);
-          }
-          return;
+      // telemetry sensors without the 'high rate' flag are decimated
+      uint32_t period10ms = getLoggingPeriod10ms();
+      bool fullLine = true;
+      if (period10ms < logDelay100ms * 10u) {
+        fullLine = (logsDecimationCount == 0);
+        if (fullLine) {
+          logsDecimationCount = logDelay100ms * 10u / period10ms;
         }
+        logsDecimationCount--;
       }
-
-      // check at every write cycle
-      if (sdCardFull) {
-        logsClose();  // timer is still running and code above will try to
-                      // open the file again but will fail with error
-                      // which will trigger the warning popup
-        return;
+      else {
+        logsDecimationCount = 0;
       }
 
+      LogsLine line;
 
 #if defined(RTCLOCK)
       {
@@ -314,10 +452,10 @@ void logsWrite()
           lastRtcTime = g_rtcTime;
           gettime(&utm);
         }
-        f_printf(&g_oLogFile, "%4d-%02d-%02d,%02d:%02d:%02d.%02d0,", utm.tm_year+TM_YEAR_BASE, utm.tm_mon+1, utm.tm_mday, utm.tm_hour, utm.tm_min, utm.tm_sec, g_ms100);
+        line.printf("%4d-%02d-%02d,%02d:%02d:%02d.%02d0,", utm.tm_year+TM_YEAR_BASE, utm.tm_mon+1, utm.tm_mday, utm.tm_hour, utm.tm_min, utm.tm_sec, g_ms100);
       }
 #else
-      f_printf(&g_oLogFile, "%d,", tmr10ms);
+      line.printf("%d,", tmr10ms);
 #endif
 
       for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
@@ -325,37 +463,42 @@ void logsWrite()
           TelemetrySensor & sensor = g_model.telemetrySensors[i];
           TelemetryItem & telemetryItem = telemetryItems[i];
           if (sensor.logs) {
-            if (sensor.unit == UNIT_GPS) {
+            if (!fullLine && !sensor.logsHighRate) {
+              line.putc(',');
+            }
+            else if (sensor.unit == UNIT_GPS) {
               if (telemetryItem.gps.longitude && telemetryItem.gps.latitude) {
                 div_t qr = div((int)telemetryItem.gps.latitude, 1000000);
-                if (telemetryItem.gps.latitude < 0) f_printf(&g_oLogFile, "-");
-                f_printf(&g_oLogFile, "%d.%06d ", abs(qr.quot), abs(qr.rem));
+                if (telemetryItem.gps.latitude < 0) line.putc('-');
+                line.printf("%d.%06d ", abs(qr.quot), abs(qr.rem));
                 qr = div((int)telemetryItem.gps.longitude, 1000000);
-                if (telemetryItem.gps.longitude < 0) f_printf(&g_oLogFile, "-");
-                f_printf(&g_oLogFile, "%d.%06d,", abs(qr.quot), abs(qr.rem));
+                if (telemetryItem.gps.longitude < 0) line.putc('-');
+                line.printf("%d.%06d,", abs(qr.quot), abs(qr.rem));
               }
               else {
-                f_printf(&g_oLogFile, ",");
+                line.putc(',');
               }
             }
             else if (sensor.unit == UNIT_DATETIME) {
-              f_printf(&g_oLogFile, "%4d-%02d-%02d %02d:%02d:%02d,", telemetryItem.datetime.year, telemetryItem.datetime.month, telemetryItem.datetime.day, telemetryItem.datetime.hour, telemetryItem.datetime.min, telemetryItem.datetime.sec);
+              line.printf("%4d-%02d-%02d %02d:%02d:%02d,", telemetryItem.datetime.year, telemetryItem.datetime.month, telemetryItem.datetime.day, telemetryItem.datetime.hour, telemetryItem.datetime.min, telemetryItem.datetime.sec);
             }
             else if (sensor.unit == UNIT_TEXT) {
-              f_printf(&g_oLogFile, "\"%s\",", telemetryItem.text);
+              line.putc('"');
+              line.puts(telemetryItem.text);
+              line.puts("\",");
             }
             else if (sensor.prec == 2) {
               div_t qr = div((int)telemetryItem.value, 100);
-              if (telemetryItem.value < 0) f_printf(&g_oLogFile, "-");
-              f_printf(&g_oLogFile, "%d.%02d,", abs(qr.quot), abs(qr.rem));
+              if (telemetryItem.value < 0) line.putc('-');
+              line.printf("%d.%02d,", abs(qr.quot), abs(qr.rem));
             }
             else if (sensor.prec == 1) {
               div_t qr = div((int)telemetryItem.value, 10);
-              if (telemetryItem.value < 0) f_printf(&g_oLogFile, "-");
-              f_printf(&g_oLogFile, "%d.%d,", abs(qr.quot), abs(qr.rem));
+              if (telemetryItem.value < 0) line.putc('-');
+              line.printf("%d.%d,", abs(qr.quot), abs(qr.rem));
             }
             else {
-              f_printf(&g_oLogFile, "%d,", telemetryItem.value);
+              line.printf("%d,", (int)telemetryItem.value);
             }
           }
         }
@@ -365,7 +508,7 @@ void logsWrite()
       auto offset = adcGetInputOffset(ADC_INPUT_MAIN);
 
       for (uint8_t i = 0; i < n_inputs; i++) {
-        f_printf(&g_oLogFile, "%d,", calibratedAnalogs[inputMappingConvertMode(offset + i)]);
+        line.printf("%d,", calibratedAnalogs[inputMappingConvertMode(offset + i)]);
       }
 
       n_inputs = adcGetMaxInputs(ADC_INPUT_FLEX);
@@ -373,35 +516,34 @@ void logsWrite()
 
       for (uint8_t i = 0; i < n_inputs; i++) {
         if (IS_POT_AVAILABLE(i))
-          f_printf(&g_oLogFile, "%d,", calibratedAnalogs[offset + i]);
+          line.printf("%d,", calibratedAnalogs[offset + i]);
       }
 
       for (uint8_t i = 0; i < switchGetMaxSwitches(); i++) {
         if (SWITCH_EXISTS(i)) {
-          f_printf(&g_oLogFile, "%d,", getSwitchState(i));
+          line.printf("%d,", getSwitchState(i));
         }
       }
-      f_printf(&g_oLogFile, "0x%08X%08X,", getLogicalSwitchesStates(32),
-               getLogicalSwitchesStates(0));
+      line.printf("0x%08X%08X,", (unsigned)getLogicalSwitchesStates(32),
+                  (unsigned)getLogicalSwitchesStates(0));
 
       for (uint8_t channel = 0; channel < MAX_OUTPUT_CHANNELS; channel++) {
-        f_printf(&g_oLogFile, "%d,", PPM_CENTER+channelOutputs[channel]/2); // in us
+        line.printf("%d,", PPM_CENTER+channelOutputs[channel]/2); // in us
       }
 
       div_t qr = div(g_vbat100mV, 10);
-      int result = f_printf(&g_oLogFile, "%d.%d\n", abs(qr.quot), abs(qr.rem));
+      line.printf("%d.%d\n", abs(qr.quot), abs(qr.rem));
 
-      if (result<0 && !error_displayed) {
-        error_displayed = STR_SDCARD_ERROR;
-        POPUP_WARNING_ON_UI_TASK(STR_SDCARD_ERROR, nullptr, false);
-        logsClose();
+      logsCloseRequest = false;
+      if (!line.commit()) {
+        TRACE("logs: buffer full, line dropped");
       }
     }
   }
   else {
-    error_displayed = nullptr;
-    logsClose();
-    
+    logsError = nullptr;
+    logsCloseRequest = true;
+
     #if !defined(SIMU)
     loggingTimerStop();
     #endif
@@ -28,6 +28,7 @@
 #include "libopenui.h"
 #include "widget.h"
 #include "theme.h"
+#include "bitmap_cache.h"
 
 #include "lua_api.h"
 #include "api_colorlcd.h"
@@ -544,10 +545,11 @@ static int luaOpenBitmap(lua_State *L)
           luaExtraMemoryUsage, LUA_MEM_EXTRA_MAX);
     *b = 0;
   } else {
-    *b = BitmapBuffer::loadBitmap(filename);
+    // shared with the other scripts and the widgets: read-only
+    *b = (BitmapBuffer *)bitmapCache.acquire(filename);
     if (*b == NULL && G(L)->gcrunning) {
       luaC_fullgc(L, 1);                       /* try to free some memory... */
-      *b = BitmapBuffer::loadBitmap(filename); /* try again */
+      *b = (BitmapBuffer *)bitmapCache.acquire(filename); /* try again */
     }
   }
 
@@ -688,7 +690,8 @@ static int luaDestroyBitmap(lua_State * L)
     else {
       luaExtraMemoryUsage = 0;
     }
-    delete b;
+    // Bitmap.resize() results don't come from the cache
+    if (!bitmapCache.release(b)) delete b;
   }
   return 0;
 }
@@ -413,21 +413,64 @@ const LuaMultipleField luaMultipleFields[] = {
     {MIXSRC_FIRST_HELI, "cyc", "Cyclic %d", 3},
 };
 
-static bool _searchSingleFields(const char* name, LuaField& field,
-                                unsigned int flags,
-                                const LuaSingleField* fields, size_t n_fields)
+// Hardware inputs and well known single fields indexed by name
+#define LUA_FIELDS_HASH_BITS  7
+#define LUA_FIELDS_HASH_SIZE  (1 << LUA_FIELDS_HASH_BITS)
+
+static_assert(DIM(_lua_inputs) + DIM(luaSingleFields) <= LUA_FIELDS_HASH_SIZE / 2,
+              "luaFieldsHash is too small");
+
+static const LuaSingleField* luaFieldsHash[LUA_FIELDS_HASH_SIZE];
+static bool luaFieldsHashValid = false;
+
+static inline uint8_t getFieldHash(const char* name)
+{
+  uint32_t key = 0;
+  while (*name) {
+    key = key * 31 + (uint8_t)*name++;
+  }
+  return (key * 2654435761u) >> (32 - LUA_FIELDS_HASH_BITS);
+}
+
+static void insertSingleFields(const LuaSingleField* fields, size_t n_fields)
 {
   for (unsigned int n = 0; n < n_fields; ++n) {
-    if (!strcmp(name, fields[n].name)) {
-      field.id = fields[n].id;
+    // open addressing: the first field with a name wins
+    uint8_t hash = getFieldHash(fields[n].name);
+    while (luaFieldsHash[hash] &&
+           strcmp(luaFieldsHash[hash]->name, fields[n].name)) {
+      hash = (hash + 1) & (LUA_FIELDS_HASH_SIZE - 1);
+    }
+    if (!luaFieldsHash[hash]) {
+      luaFieldsHash[hash] = &fields[n];
+    }
+  }
+}
+
+static bool _searchSingleFields(const char* name, LuaField& field,
+                                unsigned int flags)
+{
+  if (!luaFieldsHashValid) {
+    // the hardware inputs are searched first
+    insertSingleFields(_lua_inputs, DIM(_lua_inputs));
+    insertSingleFields(luaSingleFields, DIM(luaSingleFields));
+    luaFieldsHashValid = true;
+  }
+
+  uint8_t hash = getFieldHash(name);
+  while (luaFieldsHash[hash]) {
+    const LuaSingleField* f = luaFieldsHash[hash];
+    if (!strcmp(name, f->name)) {
+      field.id = f->id;
       if (flags & FIND_FIELD_DESC) {
-        strncpy(field.desc, fields[n].desc, sizeof(field.desc) - 1);
+        strncpy(field.desc, f->desc, sizeof(field.desc) - 1);
         field.desc[sizeof(field.desc) - 1] = '\0';
       } else {
         field.desc[0] = '\0';
       }
       return true;
     }
+    hash = (hash + 1) & (LUA_FIELDS_HASH_SIZE - 1);
   }
 
   return false;
@@ -442,12 +485,8 @@ bool luaFindFieldByName(const char * name, LuaField & field, unsigned int flags)
   strncpy(field.name, name, sizeof(field.name) - 1);
   field.name[sizeof(field.name) - 1] = '\0';
 
-  // hardware specific inputs
-  if (_searchSingleFields(name, field, flags, _lua_inputs, DIM(_lua_inputs)))
-    return true;
-  
-  // well known single fields
-  if (_searchSingleFields(name, field, flags, luaSingleFields, DIM(luaSingleFields)))
+  // hardware specific inputs and well known single fields
+  if (_searchSingleFields(name, field, flags))
     return true;
 
   // check switches from 'sa' to 'sz'
@@ -504,29 +543,20 @@ bool luaFindFieldByName(const char * name, LuaField & field, unsigned int flags)
     }
   }
 
-  // search in telemetry
+  // search in telemetry: the sensor label, possibly followed by '-' or '+'
   field.desc[0] = '\0';
-  for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
-    if (isTelemetryFieldAvailable(i)) {
-      const char* sensorName = g_model.telemetrySensors[i].label;
-      int len = strnlen(sensorName, TELEM_LABEL_LEN);
-      if (!strncmp(sensorName, name, len)) {
-        if (name[len] == '\0') {
-          field.id = MIXSRC_FIRST_TELEM + 3 * i;
-          field.desc[0] = '\0';
-          return true;
-        } else if (name[len] == '-' && name[len + 1] == '\0') {
-          field.id = MIXSRC_FIRST_TELEM + 3 * i + 1;
-          field.desc[0] = '\0';
-          return true;
-        } else if (name[len] == '+' && name[len + 1] == '\0') {
-          field.id = MIXSRC_FIRST_TELEM + 3 * i + 2;
-          field.desc[0] = '\0';
-          return true;
-        }
-      }
+  int index = findTelemetrySensor(name, len);
+  if (len > 1 && (name[len - 1] == '-' || name[len - 1] == '+')) {
+    int minmax = findTelemetrySensor(name, len - 1);
+    if (minmax >= 0 && (index < 0 || minmax < index)) {
+      field.id = MIXSRC_FIRST_TELEM + 3 * minmax + (name[len - 1] == '-' ? 1 : 2);
+      return true;
     }
   }
+  if (index >= 0) {
+    field.id = MIXSRC_FIRST_TELEM + 3 * index;
+    return true;
+  }
 
   return false;  // not found
 }
@@ -1987,6 +2017,7 @@ static int luaSetTelemetryValue(lua_State * L)
       telemetrySensor.subId = subId;
       telemetrySensor.instance = instance;
       telemetrySensor.init(name ? name: name_buf, unit, prec);
+      invalidateTelemetryIndex();
       lua_pushboolean(L, true);
     } else {
       lua_pushboolean(L, false);
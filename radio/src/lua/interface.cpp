@@ -30,6 +30,7 @@
 
 #include "lua_api.h"
 #include "lua_event.h"
+#include "lua_cache.h"
 
 #include "sdcard.h"
 #include "api_filesystem.h"
@@ -426,6 +427,7 @@ int luaLoadScriptFileToState(lua_State * L, const char * filename, const char *
   int lstatus;
   char lmode[6] = "bt";
   uint8_t ret = SCRIPT_NOFILE;
+  uint32_t loadStart = timersGetUsTick();
 
   if (mode != nullptr) {
     strncpy(lmode, mode, sizeof(lmode)-1);
@@ -498,6 +500,15 @@ int luaLoadScriptFileToState(lua_State * L, const char * filename, const char *
     // change file extension to binary version
     strcpy(filenameFull + fnamelen, SCRIPT_BIN_EXT);
   }
+  else if (loadFileType == 1 && strchr(lmode, 'b') && !strchr(lmode, 'c')) {
+    // source newer than .luac (or without): its bytecode may be cached
+    lstatus = luaCache.load(L, filenameFull, fnoLuaS, !strchr(lmode, 'd'));
+    if (lstatus == LUA_OK) {
+      TRACE("luaLoadScriptFileToState(%s, %s): loaded from cache", filename, lmode);
+      luaCache.recordLoad(filename, timersGetUsTick() - loadStart, true);
+      return SCRIPT_OK;
+    }
+  }
 
 //  TRACE_DEBUG("luaLoadScriptFileToState(%s, %s):\n", filename, lmode);
 //  TRACE_DEBUG("\tldfile='%s'; ldtype=%u; compile=%u;\n", filenameFull, loadFileType, scriptNeedsCompile);
@@ -534,8 +545,12 @@ int luaLoadScriptFileToState(lua_State * L, const char * filename, const char *
   }
   if (lstatus == LUA_OK) {
     if (scriptNeedsCompile && loadFileType == 1) {
-      strcpy(filenameFull + fnamelen, SCRIPT_BIN_EXT);
-      luaDumpState(L, filenameFull, &fnoLuaS, (strchr(lmode, 'd') ? 0 : 1));
+      // a .luac file is only written when requested, or as a fallback
+      if (strchr(lmode, 'c') || !strchr(lmode, 'b') ||
+          !luaCache.store(L, filenameFull, fnoLuaS, !strchr(lmode, 'd'))) {
+        strcpy(filenameFull + fnamelen, SCRIPT_BIN_EXT);
+        luaDumpState(L, filenameFull, &fnoLuaS, (strchr(lmode, 'd') ? 0 : 1));
+      }
     }
     ret = SCRIPT_OK;
   }
@@ -557,6 +572,10 @@ int luaLoadScriptFileToState(lua_State * L, const char * filename, const char *
     }
   }
 
+  if (ret == SCRIPT_OK) {
+    luaCache.recordLoad(filename, timersGetUsTick() - loadStart, false);
+  }
+
   return ret;
 }
 
@@ -1332,6 +1351,9 @@ void luaInit()
 {
   TRACE("luaInit");
 
+  // the SD card content may have changed (USB mass storage)
+  luaCache.invalidate();
+
   luaClose(&lsScripts);
   L = nullptr;
 
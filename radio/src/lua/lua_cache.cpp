@@ -0,0 +1,375 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "opentx.h"
+#include "lua_api.h"
+#include "lua_cache.h"
+
+extern "C" {
+  #include <lundump.h>
+}
+
+#define LUA_CACHE_MAGIC  "ELC1"
+
+LuaCache luaCache;
+
+PACK(struct LuaCacheHeader {
+  char magic[4];
+  lu_byte abi[LUAC_HEADERSIZE];   // as written by luaU_dump()
+});
+
+// Followed by the path of the source file and the bytecode
+PACK(struct LuaCacheRecord {
+  uint32_t pathHash;
+  uint32_t srcSize;
+  uint32_t srcTime;
+  uint32_t length;
+  uint8_t pathLen;
+  uint8_t stripped;
+  uint16_t spare;
+});
+
+static void getHeader(LuaCacheHeader& header)
+{
+  memcpy(header.magic, LUA_CACHE_MAGIC, sizeof(header.magic));
+  luaU_header(header.abi);
+}
+
+static inline uint32_t getSourceTime(const FILINFO& source)
+{
+  return ((uint32_t)source.fdate << 16) | source.ftime;
+}
+
+static inline uint32_t getRecordSize(const LuaCacheEntry& entry)
+{
+  return sizeof(LuaCacheRecord) + entry.pathLen + entry.length;
+}
+
+bool LuaCache::reset()
+{
+  entriesCount = 0;
+  staleBytes = 0;
+  fileSize = 0;
+  indexValid = true;
+
+  FIL file;
+  if (f_open(&file, LUA_CACHE_FILE, FA_CREATE_ALWAYS | FA_WRITE) != FR_OK)
+    return false;
+
+  LuaCacheHeader header;
+  getHeader(header);
+  UINT written;
+  bool ok = f_write(&file, &header, sizeof(header), &written) == FR_OK &&
+            written == sizeof(header);
+  f_close(&file);
+
+  if (ok) fileSize = sizeof(header);
+  return ok;
+}
+
+bool LuaCache::readIndex()
+{
+  entriesCount = 0;
+  staleBytes = 0;
+  fileSize = 0;
+  indexValid = true;
+
+  FIL file;
+  if (f_open(&file, LUA_CACHE_FILE, FA_OPEN_EXISTING | FA_READ) != FR_OK)
+    return false;
+
+  LuaCacheHeader header, expected;
+  getHeader(expected);
+  UINT read;
+  if (f_read(&file, &header, sizeof(header), &read) != FR_OK ||
+      read != sizeof(header) || memcmp(&header, &expected, sizeof(header))) {
+    // another firmware (Lua version, number type...)
+    f_close(&file);
+    TRACE("LuaCache: %s dropped", LUA_CACHE_FILE);
+    return reset();
+  }
+
+  uint32_t size = f_size(&file);
+  uint32_t offset = sizeof(header);
+  while (offset < size) {
+    LuaCacheRecord record;
+    if (f_lseek(&file, offset) != FR_OK ||
+        f_read(&file, &record, sizeof(record), &read) != FR_OK ||
+        read != sizeof(record) || size - offset < sizeof(record) ||
+        record.pathLen > size - offset - sizeof(record) ||
+        record.length > size - offset - sizeof(record) - record.pathLen) {
+      // interrupted while appending a record
+      f_close(&file);
+      TRACE("LuaCache: %s truncated", LUA_CACHE_FILE);
+      return reset();
+    }
+
+    LuaCacheEntry entry = {record.pathHash, record.srcSize, record.srcTime,
+                           offset,          record.length,  record.pathLen,
+                           record.stripped};
+    LuaCacheEntry* previous = nullptr;
+    for (uint8_t i = 0; i < entriesCount; i++) {
+      if (entries[i].pathHash == entry.pathHash &&
+          entries[i].pathLen == entry.pathLen) {
+        previous = &entries[i];
+        break;
+      }
+    }
+    if (previous) {
+      staleBytes += getRecordSize(*previous);
+      *previous = entry;
+    } else if (entriesCount < LUA_CACHE_ENTRIES) {
+      entries[entriesCount++] = entry;
+    } else {
+      staleBytes += getRecordSize(entry);
+    }
+    offset += getRecordSize(entry);
+  }
+
+  f_close(&file);
+  fileSize = size;
+  return true;
+}
+
+LuaCacheEntry* LuaCache::find(const char* filename, uint32_t pathHash)
+{
+  uint8_t pathLen = strlen(filename);
+  for (uint8_t i = 0; i < entriesCount; i++) {
+    if (entries[i].pathHash == pathHash && entries[i].pathLen == pathLen) {
+      return &entries[i];
+    }
+  }
+  return nullptr;
+}
+
+int LuaCache::load(lua_State* L, const char* filename, const FILINFO& source,
+                   bool stripped)
+{
+  if (!indexValid) readIndex();
+
+  uint32_t pathHash = hash(filename, strlen(filename));
+  LuaCacheEntry* entry = find(filename, pathHash);
+  if (!entry || entry->srcSize != source.fsize ||
+      entry->srcTime != getSourceTime(source) ||
+      entry->stripped != stripped) {
+    ++stats.noMisses;
+    return -1;
+  }
+
+  // the record and the chunk name ("@" + filename), read at once
+  uint32_t size = getRecordSize(*entry);
+  uint8_t* buffer = (uint8_t*)malloc(size + entry->pathLen + 2);
+  if (!buffer) {
+    ++stats.noMisses;
+    return -1;
+  }
+
+  FIL file;
+  UINT read = 0;
+  bool ok = false;
+  if (f_open(&file, LUA_CACHE_FILE, FA_OPEN_EXISTING | FA_READ) == FR_OK) {
+    ok = f_lseek(&file, entry->offset) == FR_OK &&
+         f_read(&file, buffer, size, &read) == FR_OK && read == size;
+    f_close(&file);
+  }
+
+  const LuaCacheRecord* record = (const LuaCacheRecord*)buffer;
+  const char* path = (const char*)buffer + sizeof(LuaCacheRecord);
+  int status = -1;
+  if (ok && record->pathHash == entry->pathHash &&
+      record->length == entry->length &&
+      !memcmp(path, filename, entry->pathLen)) {
+    char* chunkname = (char*)buffer + size;
+    chunkname[0] = '@';
+    memcpy(chunkname + 1, filename, entry->pathLen + 1);
+    status = luaL_loadbufferx(L, path + entry->pathLen, entry->length,
+                              chunkname, "b");
+    if (status != LUA_OK) {
+      TRACE("LuaCache: %s: %s", filename, lua_tostring(L, -1));
+      lua_pop(L, 1);
+      status = -1;
+    }
+  }
+  free(buffer);
+
+  if (status < 0) {
+    // compiled again from the source
+    staleBytes += size;
+    *entry = entries[--entriesCount];
+    ++stats.noMisses;
+    return -1;
+  }
+
+  ++stats.noHits;
+  return status;
+}
+
+struct LuaDumpBuffer {
+  uint8_t* data;
+  size_t size;
+  size_t capacity;
+};
+
+static int luaCacheWriter(lua_State* L, const void* p, size_t size, void* u)
+{
+  UNUSED(L);
+  LuaDumpBuffer* buffer = (LuaDumpBuffer*)u;
+  if (buffer->size + size > buffer->capacity) {
+    size_t capacity = max<size_t>(buffer->capacity * 2, buffer->size + size);
+    uint8_t* data = (uint8_t*)realloc(buffer->data, capacity);
+    if (!data) return 1;
+    buffer->data = data;
+    buffer->capacity = capacity;
+  }
+  memcpy(buffer->data + buffer->size, p, size);
+  buffer->size += size;
+  return 0;
+}
+
+bool LuaCache::store(lua_State* L, const char* filename,
+                     const FILINFO& source, bool stripped)
+{
+  size_t pathLen = strlen(filename);
+  if (pathLen > 255) return false;
+
+  if (!indexValid) readIndex();
+
+  LuaDumpBuffer buffer = {nullptr, 0, 0};
+  lua_lock(L);
+  int error = luaU_dump(L, getproto(L->top - 1), luaCacheWriter, &buffer,
+                        stripped);
+  lua_unlock(L);
+  if (error || !buffer.size) {
+    free(buffer.data);
+    return false;
+  }
+
+  uint32_t pathHash = hash(filename, pathLen);
+  LuaCacheEntry* entry = find(filename, pathHash);
+  if (fileSize == 0 || staleBytes > LUA_CACHE_MAX_STALE ||
+      (!entry && entriesCount == LUA_CACHE_ENTRIES)) {
+    // the other scripts will be added again when loaded
+    TRACE("LuaCache: %s rebuilt", LUA_CACHE_FILE);
+    reset();
+    entry = nullptr;
+  }
+
+  LuaCacheRecord record = {pathHash,
+                           (uint32_t)source.fsize,
+                           getSourceTime(source),
+                           (uint32_t)buffer.size,
+                           (uint8_t)pathLen,
+                           stripped,
+                           0};
+
+  FIL file;
+  bool ok = false;
+  if (fileSize > 0 &&
+      f_open(&file, LUA_CACHE_FILE, FA_OPEN_APPEND | FA_WRITE) == FR_OK) {
+    UINT written;
+    ok = f_write(&file, &record, sizeof(record), &written) == FR_OK &&
+         written == sizeof(record) &&
+         f_write(&file, filename, pathLen, &written) == FR_OK &&
+         written == pathLen &&
+         f_write(&file, buffer.data, buffer.size, &written) == FR_OK &&
+         written == buffer.size;
+    f_close(&file);
+  }
+  free(buffer.data);
+
+  if (!ok) {
+    // the next load checks the whole file again
+    indexValid = false;
+    return false;
+  }
+
+  if (entry) {
+    staleBytes += getRecordSize(*entry);
+  } else {
+    entry = &entries[entriesCount++];
+  }
+  *entry = {pathHash, record.srcSize, record.srcTime, fileSize, record.length,
+            record.pathLen, record.stripped};
+  fileSize += getRecordSize(*entry);
+
+  ++stats.noInsertions;
+  TRACE("LuaCache: %s saved (%u bytes)", filename, record.length);
+  return true;
+}
+
+// The name shown in the stats: the file name, or the folder name of
+// the "main.lua" of widgets and tools
+static void getScriptName(const char* filename, char* name)
+{
+  const char* start = strrchr(filename, '/');
+  start = start ? start + 1 : filename;
+  const char* end = start + strlen(start);
+  if (start - filename > 1 && !strncmp(start, "main.", 5)) {
+    end = start - 1;
+    start = end;
+    while (start > filename && *(start - 1) != '/') --start;
+  }
+  size_t len = min<size_t>(end - start, LUA_CACHE_SCRIPT_LEN);
+  memcpy(name, start, len);
+  name[len] = '\0';
+}
+
+void LuaCache::recordLoad(const char* filename, uint32_t duration, bool cached)
+{
+  ++stats.noLoads;
+  stats.loadDuration += duration;
+
+  char name[LUA_CACHE_SCRIPT_LEN + 1];
+  getScriptName(filename, name);
+  LuaScriptLoadStats* script = nullptr;
+  for (uint8_t i = 0; i < stats.scriptsCount; i++) {
+    if (!strcmp(stats.scripts[i].name, name)) {
+      script = &stats.scripts[i];
+      break;
+    }
+  }
+  if (!script) {
+    if (stats.scriptsCount >= LUA_CACHE_LOAD_STATS) return;
+    script = &stats.scripts[stats.scriptsCount++];
+    strcpy(script->name, name);
+  }
+
+  script->cached = cached;
+  ++script->noLoads;
+  script->lastDuration = duration;
+  if (duration > script->maxDuration) script->maxDuration = duration;
+}
+
+const LuaScriptLoadStats* LuaCache::getSlowestScript() const
+{
+  const LuaScriptLoadStats* slowest = nullptr;
+  for (uint8_t i = 0; i < stats.scriptsCount; i++) {
+    if (!slowest || stats.scripts[i].lastDuration > slowest->lastDuration)
+      slowest = &stats.scripts[i];
+  }
+  return slowest;
+}
+
+int LuaCache::getHitRate() const
+{
+  uint32_t all = stats.noHits + stats.noMisses;
+  return all ? (stats.noHits * 1000) / all : 0;
+}
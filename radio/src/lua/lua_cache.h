@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "ff.h"
+#include "sdcard.h"
+
+struct lua_State;
+
+// tunable parameters
+#define LUA_CACHE_FILE         SCRIPTS_PATH "/luac.cache"
+#define LUA_CACHE_ENTRIES      64            // no scripts
+#define LUA_CACHE_MAX_STALE    (64 * 1024)   // the file is rebuilt above
+
+#define LUA_CACHE_SCRIPT_LEN   16            // script name in the load stats
+#define LUA_CACHE_LOAD_STATS   16            // scripts in the load stats
+
+struct LuaScriptLoadStats
+{
+  char name[LUA_CACHE_SCRIPT_LEN + 1];
+  bool cached;                // last load from the cache
+  uint16_t noLoads;
+  uint32_t lastDuration;      // us
+  uint32_t maxDuration;       // us
+};
+
+struct LuaCacheStats
+{
+  uint32_t noHits;
+  uint32_t noMisses;
+  uint32_t noInsertions;
+  uint32_t noLoads;           // all scripts loaded, from the cache or not
+  uint32_t loadDuration;      // us, all loads
+  uint8_t scriptsCount;
+  LuaScriptLoadStats scripts[LUA_CACHE_LOAD_STATS];  // first scripts loaded
+};
+
+struct LuaCacheEntry
+{
+  uint32_t pathHash;
+  uint32_t srcSize;
+  uint32_t srcTime;      // FatFs date << 16 | time
+  uint32_t offset;       // of the record in the file
+  uint32_t length;       // bytecode bytes
+  uint8_t pathLen;
+  uint8_t stripped;
+};
+
+// Bytecode of the Lua scripts compiled by the radio, in a single file
+// on the SD card, so that a script is loaded with one contiguous read:
+// - the file starts with the Lua bytecode header of the firmware (the
+//   ABI), and is dropped when it doesn't match
+// - records are appended, keyed by source path, size and modification
+//   time, and debug info stripping
+// - a record replaces the previous ones for the same script, the file
+//   being rebuilt once LUA_CACHE_MAX_STALE bytes are stale
+//
+// Scripts are only loaded from the Lua task.
+class LuaCache
+{
+ public:
+  // Loads the cached bytecode of 'filename' (the source file) on the
+  // stack, returns -1 when it isn't cached, or the luaL_loadbuffer()
+  // status
+  int load(lua_State* L, const char* filename, const FILINFO& source,
+           bool stripped);
+
+  // Saves the function on the top of the stack, just compiled from
+  // 'filename'
+  bool store(lua_State* L, const char* filename, const FILINFO& source,
+             bool stripped);
+
+  // Forgets the index, the file being read again on next load
+  void invalidate() { indexValid = false; }
+
+  // Accounts the load of 'filename' which took 'duration' us
+  void recordLoad(const char* filename, uint32_t duration, bool cached);
+
+  const LuaCacheStats& getStats() const { return stats; }
+  int getHitRate() const;
+
+  // The slowest script (last load), nullptr before any load
+  const LuaScriptLoadStats* getSlowestScript() const;
+
+ protected:
+  LuaCacheEntry entries[LUA_CACHE_ENTRIES];
+  uint8_t entriesCount = 0;
+  uint32_t fileSize = 0;
+  uint32_t staleBytes = 0;
+  bool indexValid = false;
+  LuaCacheStats stats = {};
+
+  bool readIndex();
+  bool reset();
+  LuaCacheEntry* find(const char* filename, uint32_t pathHash);
+};
+
+extern LuaCache luaCache;
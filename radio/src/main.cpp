@@ -517,7 +517,13 @@ void guiMain(event_t evt)
     }
   }
 
+#if defined(PCBX9D) || defined(SIMU)
   if (refreshNeeded) lcdRefresh();
+#else
+  // the transfer runs with the Lua scripts of the next loop,
+  // until lcdRefreshWait()
+  if (refreshNeeded) lcdRefresh(false);
+#endif
   
   if (mainRequestFlags & (1u << REQUEST_SCREENSHOT)) {
     writeScreenshot();
@@ -546,6 +552,12 @@ void perMain()
     #endif
   }
 
+  logsFlush();             // write buffered log lines to the SD card
+
+  if (!usbPlugged() || (getSelectedUsbMode() == USB_UNSELECTED_MODE)) {
+    storagePeriodicTasks();  // disk cache read-ahead and delayed writes
+  }
+
   handleUsbConnection();
 
 #if defined(PCBXLITES)
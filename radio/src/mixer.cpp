@@ -676,14 +676,220 @@ static inline bitfield_channels_t upper_channels_mask(uint16_t ch)
 
 uint8_t mixerCurrentFlightMode;
 
-void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
+// Mix lines compiled into a list of operations, rebuilt after each
+// model change:
+// - empty lines and lines disabled in all flight modes are skipped
+// - the source kind is resolved, inputs being read directly
+// - the weights and offsets which are not GVars are precomputed
+// - the channels used as source by other channels come first, so that
+//   each line is evaluated once per cycle (unless channels depend on
+//   each other in a loop)
+
+enum MixerSourceKind {
+  MIXER_SOURCE_VALUE,     // getValue()
+  MIXER_SOURCE_INPUT,     // anas[]
+  MIXER_SOURCE_CONST,     // MIN / MAX
+  MIXER_SOURCE_CHANNEL,   // chans[]
+};
+
+#define MIXER_OP_FIRST          0x01  // first line of the channel
+#define MIXER_OP_GVAR_WEIGHT    0x02
+#define MIXER_OP_GVAR_OFFSET    0x04
+#define MIXER_OP_TRIM           0x08  // stick or input with trims
+#define MIXER_OP_TRAINER        0x10
+#define MIXER_OP_LUA            0x20
+
+struct MixerOp {
+  int32_t weight;         // calc100to256() applied
+  int32_t offset;         // in chans[] unit
+  getvalue_t value;       // MIXER_SOURCE_CONST
+  uint8_t index;          // of the mix line
+  uint8_t source;         // input or channel index
+  uint8_t kind;
+  uint8_t flags;
+};
+
+struct MixerProgram {
+  MixerOp ops[MAX_MIXERS];
+  uint8_t count;
+  bool ordered;           // false when channels depend on each other in a loop
+};
+
+static MixerProgram mixerProgram;
+static bool mixerProgramBuilt = false;
+
+void invalidateMixerProgram()
 {
-  evalInputs(mode);
+  mixerProgramBuilt = false;
+}
 
-  if (tick10ms)
-    evalLogicalSwitches(mode==e_perout_mode_normal);
+static bool isGVarField(int16_t val)
+{
+#if defined(GVARS)
+  return GV_IS_GV_VALUE(val, GV_RANGELARGE_NEG, GV_RANGELARGE);
+#else
+  return false;
+#endif
+}
+
+static bool isMixLineDisabled(const MixData * md)
+{
+  // only when the line has no effect either while disabled
+  constexpr uint16_t allFlightModes = (1 << MAX_FLIGHT_MODES) - 1;
+  return (md->flightModes & allFlightModes) == allFlightModes &&
+         ((!md->speedUp && !md->speedDown) || md->mltpx == MLTPX_REPL);
+}
+
+static void compileMixLine(MixerOp & op, uint8_t index, const MixData * md)
+{
+  mixsrc_t srcRaw = md->srcRaw;
+
+  op.index = index;
+  op.flags = 0;
+  op.value = 0;
+  op.source = 0;
+  op.kind = MIXER_SOURCE_VALUE;
+  if (srcRaw >= MIXSRC_FIRST_INPUT && srcRaw <= MIXSRC_LAST_INPUT) {
+    op.kind = MIXER_SOURCE_INPUT;
+    op.source = srcRaw - MIXSRC_FIRST_INPUT;
+  } else if (srcRaw == MIXSRC_MIN || srcRaw == MIXSRC_MAX) {
+    op.kind = MIXER_SOURCE_CONST;
+    op.value = getValue(srcRaw);
+  } else if (srcRaw >= MIXSRC_FIRST_CH && srcRaw <= MIXSRC_LAST_CH) {
+    op.kind = MIXER_SOURCE_CHANNEL;
+    op.source = srcRaw - MIXSRC_FIRST_CH;
+  } else if (srcRaw >= MIXSRC_FIRST_TRAINER && srcRaw <= MIXSRC_LAST_TRAINER) {
+    op.flags |= MIXER_OP_TRAINER;
+  }
+#if defined(LUA_MODEL_SCRIPTS)
+  else if (srcRaw >= MIXSRC_FIRST_LUA && srcRaw <= MIXSRC_LAST_LUA) {
+    op.flags |= MIXER_OP_LUA;
+  }
+#endif
+
+  if (md->carryTrim == 0 &&
+      ((srcRaw >= MIXSRC_FIRST_STICK && srcRaw <= MIXSRC_LAST_STICK) ||
+       (srcRaw >= MIXSRC_FIRST_INPUT && srcRaw <= MIXSRC_LAST_INPUT)))
+    op.flags |= MIXER_OP_TRIM;
+
+  if (isGVarField(MD_WEIGHT(md))) {
+    op.flags |= MIXER_OP_GVAR_WEIGHT;
+    op.weight = 0;
+  } else {
+    op.weight = calc100to256_16Bits(GET_GVAR_PREC1(MD_WEIGHT(md), GV_RANGELARGE_NEG, GV_RANGELARGE, 0));
+  }
+
+  if (isGVarField(MD_OFFSET(md))) {
+    op.flags |= MIXER_OP_GVAR_OFFSET;
+    op.offset = 0;
+  } else {
+    int32_t offset = GET_GVAR_PREC1(MD_OFFSET(md), GV_RANGELARGE_NEG, GV_RANGELARGE, 0);
+    op.offset = divRoundClosest(calc100toRESX_16Bits(offset), 10) << 8;
+  }
+}
+
+static void addMixLine(uint8_t index, const MixData * md)
+{
+  MixerOp & op = mixerProgram.ops[mixerProgram.count];
+  compileMixLine(op, index, md);
+  if (mixerProgram.count == 0 ||
+      mixAddress(mixerProgram.ops[mixerProgram.count - 1].index)->destCh != md->destCh)
+    op.flags |= MIXER_OP_FIRST;
+  mixerProgram.count++;
+}
+
+static void buildMixerProgram()
+{
+  // channels used as source by each channel
+  bitfield_channels_t sources[MAX_OUTPUT_CHANNELS];
+  bitfield_channels_t pending = 0;
+  memclear(sources, sizeof(sources));
+
+  uint8_t count = 0;
+  for (uint8_t i = 0; i < MAX_MIXERS; i++) {
+    MixData * md = mixAddress(i);
+    if (md->srcRaw == 0) {
+#if defined(COLORLCD)
+      continue;
+#else
+      break;
+#endif
+    }
+    count = i + 1;
+    if (isMixLineDisabled(md)) {
+      // its state is the one it would get while disabled
+      mixState[i].delay = 0;
+      mixState[i].now = mixState[i].prev = 0;
+      continue;
+    }
+    pending |= channel_bit(md->destCh);
+    if (md->srcRaw >= MIXSRC_FIRST_CH && md->srcRaw <= MIXSRC_LAST_CH) {
+      auto srcChan = md->srcRaw - MIXSRC_FIRST_CH;
+      // a channel using itself gets its previous output
+      if (srcChan < MAX_OUTPUT_CHANNELS && srcChan != md->destCh)
+        sources[md->destCh] |= channel_bit(srcChan);
+    }
+  }
+
+  // the lowest channel whose sources are all computed comes next
+  mixerProgram.count = 0;
+  mixerProgram.ordered = true;
+  while (pending) {
+    uint8_t ch = 0;
+    while (ch < MAX_OUTPUT_CHANNELS &&
+           (!channel_dirty(pending, ch) || (sources[ch] & pending)))
+      ch++;
+
+    if (ch == MAX_OUTPUT_CHANNELS) {
+      mixerProgram.ordered = false;
+      break;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+      MixData * md = mixAddress(i);
+      if (md->srcRaw != 0 && md->destCh == ch && !isMixLineDisabled(md))
+        addMixLine(i, md);
+    }
+    pending &= ~channel_bit(ch);
+  }
+
+  // loop: the lines are evaluated in the model order, in several passes
+  if (!mixerProgram.ordered) {
+    mixerProgram.count = 0;
+    for (uint8_t i = 0; i < count; i++) {
+      MixData * md = mixAddress(i);
+      if (md->srcRaw != 0 && !isMixLineDisabled(md))
+        addMixLine(i, md);
+    }
+  }
+}
+
+static const MixerProgram & getMixerProgram()
+{
+  if (!mixerProgramBuilt) {
+    mixerProgramBuilt = true;
+    buildMixerProgram();
+  }
+  return mixerProgram;
+}
+
+static inline getvalue_t getMixerOpValue(const MixerOp & op, const MixData * md)
+{
+  switch (op.kind) {
+    case MIXER_SOURCE_INPUT:
+      return anas[op.source];
+    case MIXER_SOURCE_CONST:
+      return op.value;
+    case MIXER_SOURCE_CHANNEL:
+      return ex_chans[op.source];
+    default:
+      return getValue(md->srcRaw);
+  }
+}
 
 #if defined(HELI)
+static void evalHeli()
+{
   if (modelHeliEnabled()) {
     int heliEleValue = getValue(g_model.swashR.elevatorSource);
     int heliAilValue = getValue(g_model.swashR.aileronSource);
@@ -749,42 +955,42 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
   } else {
     cyc_anas[0] = cyc_anas[1] = cyc_anas[2] = 0;
   }
+}
 #endif
 
-  memclear(chans, sizeof(chans)); // all outputs to 0
-
-  //========== MIXER LOOP ===============
-
+// Mixer loop, only the channels in 'dirtyChannels' are computed,
+// the other ones are expected to already hold their final value
+//
+// The lines are evaluated in the order of the mixer program, in a
+// single pass. When channels depend on each other, they are evaluated
+// in the model order, in several passes (at most 5), until the channels
+// using other channels as source are up to date.
+static void evalMixerLines(uint8_t mode, uint8_t tick10ms, bitfield_channels_t dirtyChannels)
+{
   uint8_t pass = 0;
   uint8_t lv_mixWarning = 0;
-  bitfield_channels_t dirtyChannels = all_channels_dirty;
 
   // Calculate locally and then copy to mixState array - prevent UI seeing phantom values while calculating
   bool activeMixes[MAX_MIXERS];
+  if (mode == e_perout_mode_normal)
+    memclear(activeMixes, sizeof(activeMixes));
+
+  const MixerProgram & program = getMixerProgram();
+  bool ordered = program.ordered;
 
   do {
     bitfield_channels_t passDirtyChannels = 0;
 
-    for (uint8_t i=0; i<MAX_MIXERS; i++) {
-      if (mode == e_perout_mode_normal && pass == 0)
-        activeMixes[i] = 0;
-
+    for (const MixerOp * op = program.ops; op < program.ops + program.count; op++) {
+      uint8_t i = op->index;
       MixData * md = mixAddress(i);
 
-      if (md->srcRaw == 0) {
-#if defined(COLORLCD)
-        continue;
-#else
-        break;
-#endif
-      }
-
       if (!channel_dirty(dirtyChannels, md->destCh))
         continue;
 
       // if this is the first calculation for the destination channel,
       // initialize it with 0 (otherwise would be random)
-      if (i == 0 || md->destCh != (md - 1)->destCh)
+      if (op->flags & MIXER_OP_FIRST)
         chans[md->destCh] = 0;
 
       //========== FLIGHT MODE && SWITCH =====
@@ -795,15 +1001,14 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
 
       if (mixLineActive) {
         // disable mixer using trainer channels if not connected
-        if (md->srcRaw >= MIXSRC_FIRST_TRAINER &&
-            md->srcRaw <= MIXSRC_LAST_TRAINER && !isTrainerValid()) {
+        if ((op->flags & MIXER_OP_TRAINER) && !isTrainerValid()) {
           mixCondition = true;
           mixEnabled = 0;
         }
 
 #if defined(LUA_MODEL_SCRIPTS)
         // disable mixer if Lua script is used as source and script was killed
-        if (md->srcRaw >= MIXSRC_FIRST_LUA && md->srcRaw <= MIXSRC_LAST_LUA) {
+        if (op->flags & MIXER_OP_LUA) {
           div_t qr = div(md->srcRaw - MIXSRC_FIRST_LUA, MAX_SCRIPT_OUTPUTS);
           if (scriptInternalData[qr.quot].state != SCRIPT_OK) {
             mixCondition = true;
@@ -818,17 +1023,16 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
 
       if (mode > e_perout_mode_inactive_flight_mode) {
         if (mixEnabled)
-          v = getValue(md->srcRaw);
+          v = getMixerOpValue(*op, md);
         else
           continue;
       } else {
-        mixsrc_t srcRaw = md->srcRaw;
-        v = getValue(srcRaw);
+        v = getMixerOpValue(*op, md);
 
-        if (srcRaw >= MIXSRC_FIRST_CH) {
+        if (op->kind == MIXER_SOURCE_CHANNEL) {
 
-          auto srcChan = srcRaw - MIXSRC_FIRST_CH;
-          if (srcChan <= MAX_OUTPUT_CHANNELS && md->destCh != srcChan) {
+          auto srcChan = op->source;
+          if (md->destCh != srcChan) {
 
             // check whether we need to recompute the current channel later
             bitfield_channels_t upperChansMask = upper_channels_mask(md->destCh);
@@ -836,13 +1040,13 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
 
             // if the source is any of the channels marked as dirty
             // or contained in [ destCh, MAX_OUTPUT_CHANNELS [
-            if (srcChanDirtyMask & (passDirtyChannels | upperChansMask)) {
+            if (!ordered && (srcChanDirtyMask & (passDirtyChannels | upperChansMask))) {
               passDirtyChannels |= channel_bit(md->destCh);
             }
 
             // if the source has already be computed,
             // then use it!
-            if (srcChan < md->destCh || pass > 0) {
+            if (ordered || srcChan < md->destCh || pass > 0 || !srcChanDirtyMask) {
               // channels are in [ -1024 * 256, 1024 * 256 ]
               v = chans[srcChan] >> 8;
             }
@@ -903,13 +1107,16 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
             applyTrims = true;
           }
         }
-        if (applyTrims && md->carryTrim == 0) {
+        if (applyTrims && (op->flags & MIXER_OP_TRIM)) {
           v += getSourceTrimValue(md->srcRaw, v);
         }
       }
 
-      int32_t weight = GET_GVAR_PREC1(MD_WEIGHT(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
-      weight = calc100to256_16Bits(weight);
+      int32_t weight = op->weight;
+      if (op->flags & MIXER_OP_GVAR_WEIGHT) {
+        weight = GET_GVAR_PREC1(MD_WEIGHT(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
+        weight = calc100to256_16Bits(weight);
+      }
       //========== SPEED ===============
       // now its on input side, but without weight compensation. More like other remote controls
       // lower weight causes slower movement
@@ -963,8 +1170,12 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
 
       //========== OFFSET / AFTER ===============
       if (applyOffsetAndCurve) {
-        int32_t offset = GET_GVAR_PREC1(MD_OFFSET(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
-        if (offset) dv += divRoundClosest(calc100toRESX_16Bits(offset), 10) << 8;
+        if (op->flags & MIXER_OP_GVAR_OFFSET) {
+          int32_t offset = GET_GVAR_PREC1(MD_OFFSET(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
+          if (offset) dv += divRoundClosest(calc100toRESX_16Bits(offset), 10) << 8;
+        } else {
+          dv += op->offset;
+        }
       }
 
       //========== DIFFERENTIAL =========
@@ -1040,12 +1251,189 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
 
   } while (++pass < 5 && dirtyChannels);
 
-  for (uint8_t i=0; i<MAX_MIXERS; i++)
-    mixState[i].activeMix = activeMixes[i];
+  // activeMixes and lv_mixWarning are only computed in normal mode
+  if (mode == e_perout_mode_normal) {
+    for (uint8_t i=0; i<MAX_MIXERS; i++)
+      mixState[i].activeMix = activeMixes[i];
 
-  mixWarning = lv_mixWarning;
+    mixWarning = lv_mixWarning;
+  }
 }
 
+void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
+{
+  evalInputs(mode);
+
+  if (tick10ms) {
+    DEBUG_TIMER_START(debugTimerEvalLogicalSwitches);
+    evalLogicalSwitches(mode==e_perout_mode_normal);
+    DEBUG_TIMER_STOP(debugTimerEvalLogicalSwitches);
+  }
+
+#if defined(HELI)
+  evalHeli();
+#endif
+
+  memclear(chans, sizeof(chans)); // all outputs to 0
+
+  //========== MIXER LOOP ===============
+  evalMixerLines(mode, tick10ms, all_channels_dirty);
+}
+
+
+
+// Values which may differ when the mixer is evaluated in two flight modes
+struct FlightModeDiff {
+  uint32_t inputs;
+  uint16_t gvars;
+  uint16_t trims;
+  bool heli;
+};
+
+static bool isGVarFieldDiff(int16_t val, int16_t min, int16_t max, uint16_t gvars)
+{
+#if defined(GVARS)
+  if (GV_IS_GV_VALUE(val, min, max)) {
+    int8_t gv = GV_INDEX_CALCULATION(val, max);
+    if (gv < 0) gv = -1 - gv;
+    return gvars & (1 << gv);
+  }
+#endif
+  return false;
+}
+
+static bool isCurveDiff(const CurveRef & curve, uint16_t gvars)
+{
+  if (curve.type == CURVE_REF_DIFF || curve.type == CURVE_REF_EXPO)
+    return isGVarFieldDiff(curve.value, -100, 100, gvars);
+  return false;
+}
+
+static bool isSwitchDiff(swsrc_t swtch)
+{
+  // logical switches have one state per flight mode
+  swtch = abs(swtch);
+  return (swtch >= SWSRC_FIRST_FLIGHT_MODE && swtch <= SWSRC_LAST_FLIGHT_MODE) ||
+         (swtch >= SWSRC_FIRST_LOGICAL_SWITCH && swtch <= SWSRC_LAST_LOGICAL_SWITCH);
+}
+
+static bool isSourceDiff(mixsrc_t src, const FlightModeDiff & diff, bitfield_channels_t channels)
+{
+  if (src >= MIXSRC_FIRST_INPUT && src <= MIXSRC_LAST_INPUT)
+    return diff.inputs & (1u << (src - MIXSRC_FIRST_INPUT));
+  if (src >= MIXSRC_FIRST_HELI && src <= MIXSRC_LAST_HELI)
+    return diff.heli;
+  if (src >= MIXSRC_FIRST_TRIM && src <= MIXSRC_LAST_TRIM)
+    return diff.trims;
+  if (src >= MIXSRC_FIRST_LOGICAL_SWITCH && src <= MIXSRC_LAST_LOGICAL_SWITCH)
+    return true;
+  if (src >= MIXSRC_FIRST_CH && src <= MIXSRC_LAST_CH)
+    return channel_dirty(channels, src - MIXSRC_FIRST_CH);
+  if (src >= MIXSRC_FIRST_GVAR && src <= MIXSRC_LAST_GVAR)
+    return diff.gvars & (1 << (src - MIXSRC_FIRST_GVAR));
+  return false;
+}
+
+static bool isFlightModeMaskDiff(uint16_t flightModes, uint8_t fm1, uint8_t fm2)
+{
+  return ((flightModes >> fm1) ^ (flightModes >> fm2)) & 1;
+}
+
+// Returns the channels which output may differ between flight modes 'fm1' and 'fm2'
+// ('diff' tells which inputs, trims, gvars and heli sources differ)
+static bitfield_channels_t getFlightModeDiffChannels(uint8_t fm1, uint8_t fm2, FlightModeDiff & diff)
+{
+  memclear(&diff, sizeof(diff));
+
+  for (uint8_t i = 0; i < keysGetMaxTrims(); i++) {
+    if (getTrimValue(fm1, i) != getTrimValue(fm2, i) ||
+        (getRawTrimValue(fm1, i).mode == TRIM_MODE_3POS) != (getRawTrimValue(fm2, i).mode == TRIM_MODE_3POS))
+      diff.trims |= 1 << i;
+  }
+
+#if defined(GVARS)
+  for (uint8_t i = 0; i < MAX_GVARS; i++) {
+    if (GVAR_VALUE(i, getGVarFlightMode(fm1, i)) != GVAR_VALUE(i, getGVarFlightMode(fm2, i)))
+      diff.gvars |= 1 << i;
+  }
+#endif
+
+  for (uint8_t i = 0; i < MAX_EXPOS; i++) {
+    ExpoData * ed = expoAddress(i);
+    if (!EXPO_VALID(ed)) break; // end of list
+    if (isFlightModeMaskDiff(ed->flightModes, fm1, fm2) ||
+        isSwitchDiff(ed->swtch) ||
+        isSourceDiff(ed->srcRaw, diff, 0) ||
+        isGVarFieldDiff(ed->weight, -100, 100, diff.gvars) ||
+        isGVarFieldDiff(ed->offset, -100, 100, diff.gvars) ||
+        isCurveDiff(ed->curve, diff.gvars))
+      diff.inputs |= 1u << ed->chn;
+  }
+
+#if defined(HELI)
+  diff.heli = modelHeliEnabled() &&
+              (isSourceDiff(g_model.swashR.collectiveSource, diff, 0) ||
+               isSourceDiff(g_model.swashR.aileronSource, diff, 0) ||
+               isSourceDiff(g_model.swashR.elevatorSource, diff, 0));
+#endif
+
+  // channels may use other channels as source, so this is
+  // repeated until no more channels are added
+  bitfield_channels_t channels = 0;
+  bitfield_channels_t previous;
+  do {
+    previous = channels;
+    for (uint8_t i = 0; i < MAX_MIXERS; i++) {
+      MixData * md = mixAddress(i);
+      if (md->srcRaw == 0) {
+#if defined(COLORLCD)
+        continue;
+#else
+        break;
+#endif
+      }
+      if (channel_dirty(channels, md->destCh))
+        continue;
+      auto trimOrigin = md->carryTrim ? -1 : getSourceTrimOrigin(md->srcRaw);
+      // lines with a delay behave differently in the active flight mode
+      if (md->delayUp || md->delayDown ||
+          isFlightModeMaskDiff(md->flightModes, fm1, fm2) ||
+          isSwitchDiff(md->swtch) ||
+          isSourceDiff(md->srcRaw, diff, channels) ||
+          (trimOrigin >= 0 && (diff.trims & (1 << trimOrigin))) ||
+          isGVarFieldDiff(MD_WEIGHT(md), GV_RANGELARGE_NEG, GV_RANGELARGE, diff.gvars) ||
+          isGVarFieldDiff(MD_OFFSET(md), GV_RANGELARGE_NEG, GV_RANGELARGE, diff.gvars) ||
+          isCurveDiff(md->curve, diff.gvars))
+        channels |= channel_bit(md->destCh);
+    }
+  } while (channels != previous);
+
+  return channels;
+}
+
+// Evaluates an inactive flight mode during a fade, starting from the
+// outputs of the active flight mode in chans[]: only the inputs and
+// channels which differ between both flight modes are recomputed
+static void evalFadingFlightModeMixes(uint8_t fm, uint8_t activeFm)
+{
+  FlightModeDiff diff;
+  bitfield_channels_t channels = getFlightModeDiffChannels(fm, activeFm, diff);
+  if (!channels)
+    return;
+
+  mixerCurrentFlightMode = fm;
+
+  if (diff.inputs)
+    applyExpos(anas, e_perout_mode_inactive_flight_mode);
+  if (diff.trims)
+    evalTrims();
+#if defined(HELI)
+  if (diff.heli)
+    evalHeli();
+#endif
+
+  evalMixerLines(e_perout_mode_inactive_flight_mode, 0, channels);
+}
 
 
 #define MAX_ACT 0xffff
@@ -1099,24 +1487,48 @@ void evalMixes(uint8_t tick10ms)
   }
 
   int32_t weight = 0;
+  mixerCurrentFlightMode = fm;
+  evalFlightModeMixes(e_perout_mode_normal, tick10ms);
+
   if (flightModesFade) {
+    // the other fading flight modes only recompute what differs from the
+    // active one, so the active flight mode results are saved and restored
+    static int32_t activeChans[MAX_OUTPUT_CHANNELS];
+    static int16_t activeAnas[MAX_INPUTS];
+    static int16_t activeTrims[MAX_TRIMS];
+    static int8_t activeInputsTrims[MAX_INPUTS];
+    memcpy(activeChans, chans, sizeof(chans));
+    memcpy(activeAnas, anas, sizeof(anas));
+    memcpy(activeTrims, trims, sizeof(trims));
+    memcpy(activeInputsTrims, virtualInputsTrims, sizeof(virtualInputsTrims));
+#if defined(HELI)
+    int16_t activeCycAnas[3];
+    memcpy(activeCycAnas, cyc_anas, sizeof(cyc_anas));
+#endif
+
     memclear(sum_chans512, sizeof(sum_chans512));
     for (uint8_t p=0; p<MAX_FLIGHT_MODES; p++) {
       if (flightModesFade & (0x01 << p)) {
-        mixerCurrentFlightMode = p;
-        evalFlightModeMixes(p==fm ? e_perout_mode_normal : e_perout_mode_inactive_flight_mode, p==fm ? tick10ms : 0);
+        if (p != fm) {
+          evalFadingFlightModeMixes(p, fm);
+        }
         for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++)
           sum_chans512[i] += limit<int32_t>(-0x6fff, chans[i] >> 4, 0x6fff) * fp_act[p];
         weight += fp_act[p];
+        if (p != fm) {
+          memcpy(chans, activeChans, sizeof(chans));
+          memcpy(anas, activeAnas, sizeof(anas));
+          memcpy(trims, activeTrims, sizeof(trims));
+          memcpy(virtualInputsTrims, activeInputsTrims, sizeof(virtualInputsTrims));
+#if defined(HELI)
+          memcpy(cyc_anas, activeCycAnas, sizeof(cyc_anas));
+#endif
+        }
       }
     }
     assert(weight);
     mixerCurrentFlightMode = fm;
   }
-  else {
-    mixerCurrentFlightMode = fm;
-    evalFlightModeMixes(e_perout_mode_normal, tick10ms);
-  }
 
   //========== FUNCTIONS ===============
   // must be done after mixing because some functions use the inputs/channels values
@@ -1126,6 +1538,7 @@ void evalMixes(uint8_t tick10ms)
   
     requiredBacklightBright = g_eeGeneral.getBrightness();
 
+    DEBUG_TIMER_START(debugTimerEvalFunctions);
     if (radioGFEnabled()) {
       evalFunctions(g_eeGeneral.customFn, globalFunctionsContext);
     } else {
@@ -1136,6 +1549,7 @@ void evalMixes(uint8_t tick10ms)
     } else {
       modelFunctionsContext.reset();
     }
+    DEBUG_TIMER_STOP(debugTimerEvalFunctions);
   }
 
   //========== LIMITS ===============
@@ -50,6 +50,7 @@ void insertMix(uint8_t idx, uint8_t channel)
     }
   }
   mix->weight = 100;
+  invalidateMixerProgram();
   mixerTaskStart();
 
   _nb_mix_lines += 1;
@@ -62,6 +63,7 @@ void deleteMix(uint8_t idx)
   MixData * mix = mixAddress(idx);
   memmove(mix, mix + 1, (MAX_MIXERS - (idx + 1)) * sizeof(MixData));
   memclear(&g_model.mixData[MAX_MIXERS - 1], sizeof(MixData));
+  invalidateMixerProgram();
   mixerTaskStart();
 
   _nb_mix_lines -= 1;
@@ -78,6 +80,7 @@ void copyMix(uint8_t src, uint8_t dst, uint8_t channel)
   memmove(mix + 1, mix, trailingMixes * sizeof(MixData));
   memcpy(mix, &sourceMix, sizeof(MixData));
   mix->destCh = channel;
+  invalidateMixerProgram();
   mixerTaskStart();
 
   _nb_mix_lines += 1;
@@ -136,6 +139,7 @@ uint8_t moveMix(uint8_t idx, bool up)
 
   mixerTaskStop();
   memswap(x, y, sizeof(MixData));
+  invalidateMixerProgram();
   mixerTaskStart();
 
   storageDirty(EE_MODEL);
@@ -162,6 +162,14 @@ struct CustomFunctionsContext {
   MASK_CFN_TYPE  activeSwitches;
   tmr10ms_t lastFunctionTime[MAX_SPECIAL_FUNCTIONS];
 
+  // dispatch state, see evalFunctions()
+  uint8_t slots[MAX_SPECIAL_FUNCTIONS];  // functions with a switch
+  uint8_t slotsCount;
+  bool slotsBuilt;
+  bool repeatPending;
+  tmr10ms_t nextRepeatTime;              // earliest repeat of a function
+  uint64_t lswStates;                    // logical switches last seen
+
   inline bool isFunctionActive(uint8_t func)
   {
     return activeFunctions & ((MASK_FUNC_TYPE)1 << func);
@@ -274,6 +282,7 @@ extern uint32_t availableMemory();
 
 void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms);
 void evalMixes(uint8_t tick10ms);
+void invalidateMixerProgram();
 void doMixerCalculations();
 void doMixerPeriodicUpdates();
 
@@ -503,6 +512,7 @@ inline bool isFunctionActive(uint8_t func)
   return globalFunctionsContext.isFunctionActive(func) || modelFunctionsContext.isFunctionActive(func);
 }
 void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext & functionsContext);
+void invalidateFunctionsDispatch();
 inline void customFunctionsReset()
 {
   globalFunctionsContext.reset();
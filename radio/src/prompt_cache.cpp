@@ -0,0 +1,288 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <string.h>
+
+#include "prompt_cache.h"
+#include "audio.h"
+#include "opentx_helpers.h"
+
+#define BLOCK_NONE  0xFFFF
+
+static_assert(PROMPT_CACHE_FILENAME_LEN >= AUDIO_FILENAME_MAXLEN,
+              "Prompt cache file names too short");
+static_assert(PROMPT_CACHE_ENTRIES < PROMPT_CACHE_NONE,
+              "Too many prompt cache entries");
+
+enum PromptCacheEntryState {
+  ENTRY_FREE,
+  ENTRY_FILLING,
+  ENTRY_VALID,
+};
+
+static const PromptFormat noFormat = {};
+
+PromptCache::PromptCache() :
+  nextBlock(nullptr),
+  pool(nullptr),
+  blocksCount(0)
+{
+  memset(entries, 0, sizeof(entries));
+  clear();
+}
+
+void PromptCache::initialize(uint8_t* pool, uint32_t size)
+{
+  // the blocks chain is stored at the start of the pool
+  uint32_t count = size / (PROMPT_CACHE_BLOCK_SIZE + sizeof(uint16_t));
+  if (count >= BLOCK_NONE) count = BLOCK_NONE - 1;
+  uint32_t header = (count * sizeof(uint16_t) + 3) & ~3;
+  while (count > 0 && header + count * PROMPT_CACHE_BLOCK_SIZE > size) {
+    header = (--count * sizeof(uint16_t) + 3) & ~3;
+  }
+
+  nextBlock = (uint16_t*)pool;
+  this->pool = pool + header;
+  blocksCount = count;
+  clear();
+}
+
+void PromptCache::clear()
+{
+  for (auto& entry : entries) {
+    entry.state = ENTRY_FREE;
+    entry.generation++;
+  }
+
+  freeBlock = blocksCount ? 0 : BLOCK_NONE;
+  freeCount = blocksCount;
+  for (uint16_t i = 0; i < blocksCount; i++) {
+    nextBlock[i] = (i + 1 < blocksCount) ? i + 1 : BLOCK_NONE;
+  }
+
+  useCounter = 0;
+  memset(&stats, 0, sizeof(stats));
+}
+
+PromptCacheEntry* PromptCache::getEntry(PromptCacheHandle handle)
+{
+  if (!handle.valid() || handle.index >= PROMPT_CACHE_ENTRIES) return nullptr;
+  PromptCacheEntry& entry = entries[handle.index];
+  if (entry.state == ENTRY_FREE || entry.generation != handle.generation)
+    return nullptr;
+  return &entry;
+}
+
+PromptCacheHandle PromptCache::find(const char* filename)
+{
+  for (uint8_t i = 0; i < PROMPT_CACHE_ENTRIES; i++) {
+    PromptCacheEntry& entry = entries[i];
+    if (entry.state == ENTRY_VALID && !strcmp(entry.filename, filename)) {
+      ++stats.noHits;
+      entry.lastUse = ++useCounter;
+      return {i, entry.generation};
+    }
+  }
+  ++stats.noMisses;
+  return {PROMPT_CACHE_NONE, 0};
+}
+
+const PromptFormat& PromptCache::getFormat(PromptCacheHandle handle) const
+{
+  const PromptCacheEntry* entry =
+      const_cast<PromptCache*>(this)->getEntry(handle);
+  return entry ? entry->format : noFormat;
+}
+
+uint32_t PromptCache::read(PromptCacheHandle handle, uint32_t offset,
+                           uint8_t* dst, uint32_t count)
+{
+  PromptCacheEntry* entry = getEntry(handle);
+  if (!entry || offset >= entry->written) return 0;
+
+  count = min<uint32_t>(count, entry->written - offset);
+
+  uint16_t block = entry->firstBlock;
+  for (uint32_t skip = offset / PROMPT_CACHE_BLOCK_SIZE; skip > 0; skip--) {
+    block = nextBlock[block];
+  }
+
+  uint32_t done = 0;
+  offset %= PROMPT_CACHE_BLOCK_SIZE;
+  while (done < count) {
+    uint32_t len = min<uint32_t>(count - done, PROMPT_CACHE_BLOCK_SIZE - offset);
+    memcpy(dst + done, pool + block * PROMPT_CACHE_BLOCK_SIZE + offset, len);
+    done += len;
+    offset = 0;
+    block = nextBlock[block];
+  }
+
+  return done;
+}
+
+bool PromptCache::allocate(PromptCacheEntry& entry, uint16_t blocks)
+{
+  while (freeCount < blocks) {
+    if (!evict(&entry)) return false;
+  }
+
+  // the chain is taken from the head of the free list
+  entry.firstBlock = freeBlock;
+  uint16_t last = freeBlock;
+  for (uint16_t i = 1; i < blocks; i++) {
+    last = nextBlock[last];
+  }
+  freeBlock = nextBlock[last];
+  nextBlock[last] = BLOCK_NONE;
+  freeCount -= blocks;
+  stats.usedBytes += blocks * PROMPT_CACHE_BLOCK_SIZE;
+  return true;
+}
+
+void PromptCache::release(PromptCacheEntry& entry)
+{
+  if (entry.state == ENTRY_FREE) return;
+
+  uint16_t blocks = (entry.format.size + PROMPT_CACHE_BLOCK_SIZE - 1) /
+                    PROMPT_CACHE_BLOCK_SIZE;
+  uint16_t last = entry.firstBlock;
+  for (uint16_t i = 1; i < blocks; i++) {
+    last = nextBlock[last];
+  }
+  nextBlock[last] = freeBlock;
+  freeBlock = entry.firstBlock;
+  freeCount += blocks;
+  stats.usedBytes -= blocks * PROMPT_CACHE_BLOCK_SIZE;
+
+  entry.state = ENTRY_FREE;
+  entry.generation++;
+}
+
+bool PromptCache::evict(const PromptCacheEntry* keep)
+{
+  PromptCacheEntry* victim = nullptr;
+  for (auto& entry : entries) {
+    if (&entry == keep || entry.state == ENTRY_FREE) continue;
+    if (!victim || (int32_t)(entry.lastUse - victim->lastUse) < 0) {
+      victim = &entry;
+    }
+  }
+  if (!victim) return false;
+
+  ++stats.noEvictions;
+  release(*victim);
+  return true;
+}
+
+PromptCacheHandle PromptCache::create(const char* filename,
+                                      const PromptFormat& format)
+{
+  uint32_t blocks = (format.size + PROMPT_CACHE_BLOCK_SIZE - 1) /
+                    PROMPT_CACHE_BLOCK_SIZE;
+  if (format.size == 0 || format.size > PROMPT_CACHE_MAX_PROMPT ||
+      blocks > blocksCount || strlen(filename) > PROMPT_CACHE_FILENAME_LEN) {
+    return {PROMPT_CACHE_NONE, 0};
+  }
+
+  // a free entry, or the least recently used one
+  PromptCacheEntry* entry = nullptr;
+  for (auto& e : entries) {
+    if (e.state == ENTRY_FREE) {
+      entry = &e;
+      break;
+    }
+  }
+  if (!entry) {
+    evict(nullptr);
+    for (auto& e : entries) {
+      if (e.state == ENTRY_FREE) {
+        entry = &e;
+        break;
+      }
+    }
+  }
+  if (!entry) return {PROMPT_CACHE_NONE, 0};
+
+  // the state is set first, so that evict() skips this entry
+  strcpy(entry->filename, filename);
+  entry->format = format;
+  entry->written = 0;
+  entry->lastUse = ++useCounter;
+  entry->state = ENTRY_FILLING;
+  entry->generation++;
+  entry->firstBlock = BLOCK_NONE;
+  if (!allocate(*entry, blocks)) {
+    entry->state = ENTRY_FREE;
+    return {PROMPT_CACHE_NONE, 0};
+  }
+
+  return {(uint8_t)(entry - entries), entry->generation};
+}
+
+void PromptCache::append(PromptCacheHandle& handle, const uint8_t* data,
+                         uint32_t count)
+{
+  PromptCacheEntry* entry = getEntry(handle);
+  if (!entry || entry->state != ENTRY_FILLING) {
+    handle.index = PROMPT_CACHE_NONE;
+    return;
+  }
+
+  count = min<uint32_t>(count, entry->format.size - entry->written);
+
+  uint16_t block = entry->firstBlock;
+  for (uint32_t skip = entry->written / PROMPT_CACHE_BLOCK_SIZE; skip > 0;
+       skip--) {
+    block = nextBlock[block];
+  }
+
+  uint32_t offset = entry->written % PROMPT_CACHE_BLOCK_SIZE;
+  uint32_t done = 0;
+  while (done < count) {
+    uint32_t len = min<uint32_t>(count - done, PROMPT_CACHE_BLOCK_SIZE - offset);
+    memcpy(pool + block * PROMPT_CACHE_BLOCK_SIZE + offset, data + done, len);
+    done += len;
+    offset = 0;
+    block = nextBlock[block];
+  }
+
+  entry->written += count;
+  if (entry->written == entry->format.size) {
+    entry->state = ENTRY_VALID;
+    ++stats.noInsertions;
+    handle.index = PROMPT_CACHE_NONE;
+  }
+}
+
+void PromptCache::abort(PromptCacheHandle& handle)
+{
+  PromptCacheEntry* entry = getEntry(handle);
+  if (entry && entry->state == ENTRY_FILLING) {
+    release(*entry);
+  }
+  handle.index = PROMPT_CACHE_NONE;
+}
+
+int PromptCache::getHitRate() const
+{
+  uint32_t all = stats.noHits + stats.noMisses;
+  return all ? (stats.noHits * 1000) / all : 0;
+}
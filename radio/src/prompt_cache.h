@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// tunable parameters
+#define PROMPT_CACHE_ENTRIES       64     // no prompts
+#define PROMPT_CACHE_BLOCK_SIZE    2048   // bytes per pool block
+#define PROMPT_CACHE_MAX_PROMPT    (64 * 1024)  // longer files are not cached
+#define PROMPT_CACHE_FILENAME_LEN  48     // at least AUDIO_FILENAME_MAXLEN
+
+#define PROMPT_CACHE_NONE          0xFF
+
+struct PromptCacheStats
+{
+  uint32_t noHits;
+  uint32_t noMisses;
+  uint32_t noInsertions;
+  uint32_t noEvictions;
+  uint32_t usedBytes;
+};
+
+// Header of a WAV file, as parsed from the SD card
+struct PromptFormat
+{
+  uint8_t codec;
+  uint16_t blockSize;   // ADPCM only
+  uint32_t freq;
+  uint32_t size;        // bytes of samples
+};
+
+struct PromptCacheEntry
+{
+  char filename[PROMPT_CACHE_FILENAME_LEN + 1];
+  PromptFormat format;
+  uint32_t written;     // bytes received so far
+  uint32_t lastUse;
+  uint16_t firstBlock;
+  uint8_t generation;   // changes each time the entry is reused
+  uint8_t state;
+};
+
+// Handle on an entry: stale once the entry has been evicted
+struct PromptCacheHandle
+{
+  uint8_t index;
+  uint8_t generation;
+
+  bool valid() const { return index != PROMPT_CACHE_NONE; }
+};
+
+// Size-bounded cache of short WAV prompts (system sounds, numbers,
+// units), so that announcing a value needs no SD card access:
+// - the samples are stored as in the file, the header being parsed
+//   only once, in a pool of PROMPT_CACHE_BLOCK_SIZE blocks
+// - an entry is filled while the file is played for the first time,
+//   and is found by find() once complete
+// - the least recently used entries are evicted when the pool is full
+//
+// The cache is only accessed from the audio task.
+class PromptCache
+{
+ public:
+  PromptCache();
+
+  void initialize(uint8_t* pool, uint32_t size);
+  void clear();
+
+  // Returns an invalid handle when the prompt is not (fully) cached
+  PromptCacheHandle find(const char* filename);
+  const PromptFormat& getFormat(PromptCacheHandle handle) const;
+
+  // Copies up to 'count' bytes of samples from 'offset', returns 0
+  // when the entry has been evicted
+  uint32_t read(PromptCacheHandle handle, uint32_t offset, uint8_t* dst,
+                uint32_t count);
+
+  // Starts filling a new entry, returns an invalid handle when the
+  // prompt is too long to be cached
+  PromptCacheHandle create(const char* filename, const PromptFormat& format);
+
+  // Appends the samples read from the file, the entry being available
+  // once 'format.size' bytes have been received
+  void append(PromptCacheHandle& handle, const uint8_t* data, uint32_t count);
+
+  // Drops an entry being filled (playback stopped, read error)
+  void abort(PromptCacheHandle& handle);
+
+  const PromptCacheStats& getStats() const { return stats; }
+  int getHitRate() const;
+
+ protected:
+  PromptCacheEntry entries[PROMPT_CACHE_ENTRIES];
+  uint16_t* nextBlock;     // blocks chain, one per pool block
+  uint8_t* pool;
+  uint16_t blocksCount;
+  uint16_t freeBlock;
+  uint16_t freeCount;
+  uint32_t useCounter;
+  PromptCacheStats stats;
+
+  PromptCacheEntry* getEntry(PromptCacheHandle handle);
+  bool allocate(PromptCacheEntry& entry, uint16_t blocks);
+  void release(PromptCacheEntry& entry);
+  bool evict(const PromptCacheEntry* keep);
+};
+
+extern PromptCache promptCache;
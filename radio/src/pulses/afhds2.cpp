@@ -94,5 +94,6 @@ const etx_proto_driver_t Afhds2InternalDriver = {
   .sendPulses = afhds2SendPulses,
   .processData = afhds2ProcessData,
   .processFrame = nullptr,
+  .processBuffer = nullptr,
   .onConfigChange = nullptr,
 };
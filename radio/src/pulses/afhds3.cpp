@@ -1166,6 +1166,7 @@ etx_proto_driver_t ProtoDriver = {
     .sendPulses = sendPulses,
     .processData = processTelemetryData,
     .processFrame = nullptr,
+    .processBuffer = nullptr,
     .onConfigChange = nullptr,
 };
 
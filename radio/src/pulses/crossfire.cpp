@@ -341,5 +341,6 @@ const etx_proto_driver_t CrossfireDriver = {
   .sendPulses = crossfireSendPulses,
   .processData = nullptr,
   .processFrame = crossfireProcessFrame,
+  .processBuffer = nullptr,
   .onConfigChange = nullptr,
 };
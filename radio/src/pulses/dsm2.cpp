@@ -297,6 +297,7 @@ const etx_proto_driver_t DSM2Driver = {
   .sendPulses = dsm2SendPulses,
   .processData = nullptr,
   .processFrame = nullptr,
+  .processBuffer = nullptr,
   .onConfigChange = dsm2ConfigChange,
 };
 
@@ -307,5 +308,6 @@ const etx_proto_driver_t DSMPDriver = {
   .sendPulses = dsmpSendPulses,
   .processData = dsmpProcessData,
   .processFrame = nullptr,
+  .processBuffer = nullptr,
   .onConfigChange = nullptr,
 };
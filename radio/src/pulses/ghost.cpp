@@ -246,6 +246,14 @@ static void ghostProcessData(void* ctx, uint8_t data, uint8_t* buffer, uint8_t*
   }
 }
 
+static void ghostProcessBuffer(void* ctx, const uint8_t* data, uint32_t len,
+                               uint8_t* buffer, uint8_t* p_len)
+{
+  while (len--) {
+    ghostProcessData(ctx, *data++, buffer, p_len);
+  }
+}
+
 const etx_proto_driver_t GhostDriver = {
   .protocol = PROTOCOL_CHANNELS_GHOST,
   .init = ghostInit,
@@ -253,5 +261,6 @@ const etx_proto_driver_t GhostDriver = {
   .sendPulses = ghostSendPulses,
   .processData = ghostProcessData,
   .processFrame = nullptr,
+  .processBuffer = ghostProcessBuffer,
   .onConfigChange = nullptr,
 };
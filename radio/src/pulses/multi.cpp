@@ -278,6 +278,17 @@ static void multiProcessData(void* ctx, uint8_t data, uint8_t* buffer, uint8_t*
   processMultiTelemetryData(data, module);
 }
 
+static void multiProcessBuffer(void* ctx, const uint8_t* data, uint32_t len,
+                               uint8_t* buffer, uint8_t* p_len)
+{
+  auto mod_st = (etx_module_state_t*)ctx;
+  auto module = modulePortGetModule(mod_st);
+
+  while (len--) {
+    processMultiTelemetryData(*data++, module);
+  }
+}
+
 #include "hal/module_driver.h"
 
 const etx_proto_driver_t MultiDriver = {
@@ -287,6 +298,7 @@ const etx_proto_driver_t MultiDriver = {
   .sendPulses = multiSendPulses,
   .processData = multiProcessData,
   .processFrame = nullptr,
+  .processBuffer = multiProcessBuffer,
   .onConfigChange = nullptr,
 };
 
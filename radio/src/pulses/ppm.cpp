@@ -220,5 +220,6 @@ const etx_proto_driver_t PpmDriver = {
   .sendPulses = ppmSendPulses,
   .processData = ppmProcessTelemetryData,
   .processFrame = nullptr,
+  .processBuffer = nullptr,
   .onConfigChange = ppmOnConfigChange,
 };
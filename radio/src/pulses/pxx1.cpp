@@ -408,6 +408,17 @@ static void pxx1ProcessData(void* ctx, uint8_t data, uint8_t* buffer, uint8_t* l
   processFrskySportTelemetryData(module, data, buffer, *len);
 }
 
+static void pxx1ProcessBuffer(void* ctx, const uint8_t* data, uint32_t len,
+                              uint8_t* buffer, uint8_t* p_len)
+{
+  auto mod_st = (etx_module_state_t*)ctx;
+  auto module = modulePortGetModule(mod_st);
+
+  while (len--) {
+    processFrskySportTelemetryData(module, *data++, buffer, *p_len);
+  }
+}
+
 const etx_proto_driver_t Pxx1Driver = {
   .protocol = PROTOCOL_CHANNELS_PXX1,
   .init = pxx1Init,
@@ -415,5 +426,6 @@ const etx_proto_driver_t Pxx1Driver = {
   .sendPulses = pxx1SendPulses,
   .processData = pxx1ProcessData,
   .processFrame = nullptr,
+  .processBuffer = pxx1ProcessBuffer,
   .onConfigChange = nullptr,
 };
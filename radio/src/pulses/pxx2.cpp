@@ -832,6 +832,14 @@ static void pxx2ProcessData(void* ctx, uint8_t data, uint8_t* buffer, uint8_t* l
   *len = 0;
 }
 
+static void pxx2ProcessBuffer(void* ctx, const uint8_t* data, uint32_t len,
+                              uint8_t* buffer, uint8_t* p_len)
+{
+  while (len--) {
+    pxx2ProcessData(ctx, *data++, buffer, p_len);
+  }
+}
+
 #include "hal/module_driver.h"
 // #include "extmodule_serial_driver.h"
 
@@ -842,5 +850,6 @@ const etx_proto_driver_t Pxx2Driver = {
   .sendPulses = pxx2SendPulses,
   .processData = pxx2ProcessData,
   .processFrame = nullptr,
+  .processBuffer = pxx2ProcessBuffer,
   .onConfigChange = nullptr,
 };
@@ -155,5 +155,6 @@ const etx_proto_driver_t SBusDriver = {
   .sendPulses = sbusSendPulses,
   .processData = nullptr,
   .processFrame = nullptr,
+  .processBuffer = nullptr,
   .onConfigChange = nullptr,
 };
@@ -69,9 +69,11 @@ const char RADIO_SETTINGS_PATH[] = RADIO_PATH PATH_SEPARATOR RADIO_FILENAME;
 #if defined(SDCARD_YAML)
 #define LABELS_FILENAME     "labels.yml"
 #define MODELS_FILENAME     "models.yml"
+#define LABELS_CACHE_FILENAME "labels.bin"
 const char MODELSLIST_YAML_PATH[] = MODELS_PATH PATH_SEPARATOR MODELS_FILENAME;
 const char FALLBACK_MODELSLIST_YAML_PATH[] = RADIO_PATH PATH_SEPARATOR MODELS_FILENAME;
 const char LABELSLIST_YAML_PATH[] = MODELS_PATH PATH_SEPARATOR LABELS_FILENAME;
+const char LABELSLIST_CACHE_PATH[] = MODELS_PATH PATH_SEPARATOR LABELS_CACHE_FILENAME;
 const char RADIO_SETTINGS_YAML_PATH[] = RADIO_PATH PATH_SEPARATOR "radio.yml";
 const char RADIO_SETTINGS_TMPFILE_YAML_PATH[] = RADIO_PATH PATH_SEPARATOR "radio_new.yml";
 const char RADIO_SETTINGS_ERRORFILE_YAML_PATH[] = RADIO_PATH PATH_SEPARATOR "radio_error.yml";
@@ -88,6 +90,7 @@ const char YAMLFILE_CHECKSUM_TAG_NAME[] = "checksum";
 #define BMP_EXT             ".bmp"
 #define PNG_EXT             ".png"
 #define JPG_EXT             ".jpg"
+#define THUMBNAIL_EXT       ".thb"
 #define SCRIPT_EXT          ".lua"
 #define SCRIPT_BIN_EXT      ".luac"
 #define TEXT_EXT            ".txt"
@@ -121,9 +124,11 @@ const char YAMLFILE_CHECKSUM_TAG_NAME[] = "checksum";
   strcat(&filename[sizeof(path)], ext)
 
 extern uint8_t logDelay100ms;
+extern uint8_t logHighRate10ms;
 void logsInit();
 void logsClose();
 void logsWrite();
+void logsFlush();
 
 void sdInit();
 void sdMount();
@@ -1009,6 +1009,213 @@ char *FILInfoToHexStr(char buffer[17], FILINFO *finfo)
   return buffer;
 }
 
+/**
+ * @brief Binary copy of labels.yml
+ *
+ * Written each time labels.yml is saved, so that the models list can be
+ * restored with a single read instead of parsing labels.yml. It is only
+ * used if labels.yml has not been changed since (size & date stored in
+ * the header). Models whose file hash differs are reloaded as usual.
+ *
+ * Layout: header, labels (selected flag + NUL terminated name), then
+ * one record per model, each followed by its labels as CSV.
+ */
+
+#define MODELS_CACHE_MAGIC    0x4C4D5445  // "ETML"
+#define MODELS_CACHE_VERSION  1
+
+PACK(struct ModelsCacheHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t recordSize;
+  FInfoH labelsInfo;
+  uint16_t crc;
+  uint16_t labelsCount;
+  uint16_t modelsCount;
+  uint8_t sortOrder;
+});
+
+PACK(struct ModelsCacheRecord {
+  char filename[LEN_MODEL_FILENAME + 1];
+  char name[LEN_MODEL_NAME + 1];
+  char hash[FILE_HASH_LENGTH + 1];
+#if LEN_BITMAP_NAME > 0
+  char bitmap[LEN_BITMAP_NAME + 1];
+#endif
+  gtime_t lastOpened;
+  uint8_t modelId[NUM_MODULES];
+  uint8_t moduleType[NUM_MODULES];
+  uint8_t moduleSubType[NUM_MODULES];
+  uint16_t labelsLen;
+});
+
+// Walks the cache content, and applies it only if 'apply' is set,
+// so that a corrupted file does not leave a half loaded list behind
+bool ModelsList::parseCache(const uint8_t *data, uint32_t size, bool apply)
+{
+  auto header = (const ModelsCacheHeader *)data;
+  const uint8_t *p = data + sizeof(ModelsCacheHeader);
+  const uint8_t *end = data + size;
+
+  for (unsigned i = 0; i < header->labelsCount; i++) {
+    if (p + 1 >= end) return false;
+    bool selected = *p++;
+    auto label = (const char *)p;
+    size_t len = strnlen(label, (size_t)(end - p));
+    if (p + len >= end) return false;
+    p += len + 1;
+    if (apply) {
+      modelslabels.addLabel(label);
+      if (selected) modelslabels.addFilteredLabel(label);
+    }
+  }
+
+  if (apply) modelslabels.setSortOrder((ModelsSortBy)header->sortOrder);
+
+  for (unsigned i = 0; i < header->modelsCount; i++) {
+    ModelsCacheRecord rec;
+    if (p + sizeof(rec) > end) return false;
+    memcpy(&rec, p, sizeof(rec));
+    p += sizeof(rec);
+    auto labels = (const char *)p;
+    if (p + rec.labelsLen > end) return false;
+    p += rec.labelsLen;
+    if (!apply) continue;
+
+    rec.filename[LEN_MODEL_FILENAME] = '\0';
+    rec.name[LEN_MODEL_NAME] = '\0';
+    rec.hash[FILE_HASH_LENGTH] = '\0';
+
+    for (auto &filehash : fileHashInfo) {
+      if (filehash.name != rec.filename) continue;
+      if (filehash.celladded) break;
+
+      ModelCell *model = new ModelCell(rec.filename);
+      strcpy(model->modelFinfoHash, filehash.hash);
+      push_back(model);
+      filehash.celladded = true;
+      if (filehash.curmodel) setCurrentModel(model);
+
+      model->lastOpened = rec.lastOpened;
+      if (!strcmp(filehash.hash, rec.hash)) {
+        model->setModelName(rec.name);
+#if LEN_BITMAP_NAME > 0
+        rec.bitmap[LEN_BITMAP_NAME] = '\0';
+        strcpy(model->modelBitmap, rec.bitmap);
+#endif
+        std::string csv(labels, rec.labelsLen);
+        for (const auto &lbl : ModelMap::fromCSV(csv.c_str())) {
+          modelslabels.addLabelToModel(lbl, model);
+        }
+        for (int j = 0; j < NUM_MODULES; j++) {
+          model->modelId[j] = rec.modelId[j];
+          model->moduleData[j].type = rec.moduleType[j];
+          model->moduleData[j].subType = rec.moduleSubType[j];
+        }
+        model->valid_rfData = true;
+        model->_isDirty = false;
+      } else {
+        model->_isDirty = true;
+      }
+      break;
+    }
+  }
+
+  return p == end;
+}
+
+bool ModelsList::loadCache()
+{
+  FILINFO fno;
+  if (f_stat(LABELSLIST_YAML_PATH, &fno) != FR_OK) return false;
+
+  if (f_open(&file, LABELSLIST_CACHE_PATH, FA_OPEN_EXISTING | FA_READ) != FR_OK)
+    return false;
+
+  UINT size = f_size(&file);
+  uint8_t *data = size >= sizeof(ModelsCacheHeader) ? (uint8_t *)malloc(size) : nullptr;
+  UINT bytes_read = 0;
+  if (data) f_read(&file, data, size, &bytes_read);
+  f_close(&file);
+
+  bool valid = false;
+  if (data && bytes_read == size) {
+    auto header = (const ModelsCacheHeader *)data;
+    valid = header->magic == MODELS_CACHE_MAGIC &&
+            header->version == MODELS_CACHE_VERSION &&
+            header->recordSize == sizeof(ModelsCacheRecord) &&
+            !memcmp(&header->labelsInfo, &fno, sizeof(FInfoH)) &&
+            header->crc == crc16(0, data + sizeof(ModelsCacheHeader),
+                                 size - sizeof(ModelsCacheHeader), 0xFFFF) &&
+            parseCache(data, size, false);
+    if (valid) parseCache(data, size, true);
+  }
+
+  free(data);
+  TRACE_LABELS("Labels: cache %s", valid ? "loaded" : "invalid");
+  return valid;
+}
+
+void ModelsList::saveCache(const LabelsVector &labels)
+{
+  ModelsCacheHeader header;
+  memclear(&header, sizeof(header));
+  header.magic = MODELS_CACHE_MAGIC;
+  header.version = MODELS_CACHE_VERSION;
+  header.recordSize = sizeof(ModelsCacheRecord);
+  header.labelsCount = labels.size();
+  header.modelsCount = size();
+  header.sortOrder = modelslabels.sortOrder();
+
+  FILINFO fno;
+  if (f_stat(LABELSLIST_YAML_PATH, &fno) != FR_OK) {
+    f_unlink(LABELSLIST_CACHE_PATH);
+    return;
+  }
+  memcpy(&header.labelsInfo, &fno, sizeof(FInfoH));
+
+  std::string data;
+  for (const auto &lbl : labels) {
+    data += (char)modelslabels.isLabelFiltered(lbl);
+    data.append(lbl.c_str(), lbl.size() + 1);
+  }
+
+  for (auto model : *this) {
+    ModelsCacheRecord rec;
+    memclear(&rec, sizeof(rec));
+    strncpy(rec.filename, model->modelFilename, LEN_MODEL_FILENAME);
+    strncpy(rec.name, model->modelName, LEN_MODEL_NAME);
+    strncpy(rec.hash, model->modelFinfoHash, FILE_HASH_LENGTH);
+#if LEN_BITMAP_NAME > 0
+    strncpy(rec.bitmap, model->modelBitmap, LEN_BITMAP_NAME);
+#endif
+    rec.lastOpened = model->lastOpened;
+    for (int i = 0; i < NUM_MODULES; i++) {
+      rec.modelId[i] = model->modelId[i];
+      rec.moduleType[i] = model->moduleData[i].type;
+      rec.moduleSubType[i] = model->moduleData[i].subType;
+    }
+    std::string csv = ModelMap::toCSV(modelslabels.getLabelsByModel(model));
+    rec.labelsLen = csv.size();
+    data.append((const char *)&rec, sizeof(rec));
+    data += csv;
+  }
+
+  header.crc = crc16(0, (const uint8_t *)data.data(), data.size(), 0xFFFF);
+
+  if (f_open(&file, LABELSLIST_CACHE_PATH, FA_CREATE_ALWAYS | FA_WRITE) != FR_OK)
+    return;
+
+  UINT written;
+  bool ok = f_write(&file, &header, sizeof(header), &written) == FR_OK &&
+            written == sizeof(header) &&
+            f_write(&file, data.data(), data.size(), &written) == FR_OK &&
+            written == data.size();
+  f_close(&file);
+
+  if (!ok) f_unlink(LABELSLIST_CACHE_PATH);
+}
+
 /**
  * @brief Loads the Labels and Models from the labels.yml file
  *
@@ -1156,24 +1363,28 @@ bool ModelsList::loadYaml()
         debugTimers[debugTimerYamlScan].getLast());
 #endif
 
-  // Scan labels.yml
-  result = f_open(&file, LABELSLIST_YAML_PATH, FA_OPEN_EXISTING | FA_READ);
-  if (result == FR_OK) {
-    YamlParser yp;
-    void *ctx = get_labelslist_iter();
-    yp.init(get_labelslist_parser_calls(), ctx);
-    UINT bytes_read = 0;
-    while (f_read(&file, line, sizeof(line), &bytes_read) == FR_OK) {
-      if (bytes_read == 0) break;
-      if (f_eof(&file)) yp.set_eof();
-      if (yp.parse(line, bytes_read) != YamlParser::CONTINUE_PARSING) break;
+  // Restore from labels.bin if still in sync, or scan labels.yml
+  bool cacheLoaded = loadCache();
+  if (!cacheLoaded) {
+    result = f_open(&file, LABELSLIST_YAML_PATH, FA_OPEN_EXISTING | FA_READ);
+    if (result == FR_OK) {
+      YamlParser yp;
+      void *ctx = get_labelslist_iter();
+      yp.init(get_labelslist_parser_calls(), ctx);
+      UINT bytes_read = 0;
+      while (f_read(&file, line, sizeof(line), &bytes_read) == FR_OK) {
+        if (bytes_read == 0) break;
+        if (f_eof(&file)) yp.set_eof();
+        if (yp.parse(line, bytes_read) != YamlParser::CONTINUE_PARSING) break;
+      }
+      f_close(&file);
     }
-    f_close(&file);
   }
 
 #if defined(DEBUG_TIMERS)
   DEBUG_TIMER_SAMPLE(debugTimerYamlScan);
-  TRACE("Lables: Time to scan labels.yml %luus",
+  TRACE("Lables: Time to %s %luus",
+        cacheLoaded ? "load labels.bin" : "scan labels.yml",
         debugTimers[debugTimerYamlScan].getLast());
 #endif
 
@@ -1212,6 +1423,7 @@ bool ModelsList::loadYaml()
     modelslist.save();
   } else {
     TRACE_LABELS("LABELS.YML Is in Sync! No models were read");
+    if (!cacheLoaded) saveCache(modelslabels.getLabels());
   }
 
   // If no labels found. Add a favorites label
@@ -1236,6 +1448,7 @@ bool ModelsList::load(Format fmt)
 {
   if (loaded) return true;
 
+  uint32_t startMs = timersGetMsTick();
   bool res = false;
 #if !defined(SDCARD_YAML)
   (void)fmt;
@@ -1269,6 +1482,7 @@ bool ModelsList::load(Format fmt)
   }
 
   loaded = true;
+  loadDuration = timersGetMsTick() - startMs;
   return res;
 }
 
@@ -1348,6 +1562,10 @@ const char *ModelsList::save(LabelsVector newOrder)
   f_close(&file);
   modelslabels._isDirty = false;
 
+#if defined(SDCARD_YAML)
+  saveCache(newOrder);
+#endif
+
   return NULL;
 }
 
@@ -219,6 +219,8 @@ class ModelsList : public ModelsVector
 
   ModelCell *currentModel;
 
+  uint32_t loadDuration = 0;
+
   void init();
 
  public:
@@ -245,6 +247,9 @@ class ModelsList : public ModelsVector
 
   ModelCell *getCurrentModel() const { return currentModel; }
 
+  // Time spent in the last load() (ms)
+  uint32_t getLoadDuration() const { return loadDuration; }
+
   unsigned int getModelsCount() const
   {
     return std::vector<ModelCell *>::size();
@@ -274,6 +279,9 @@ class ModelsList : public ModelsVector
 #if defined(SDCARD_YAML)
   bool loadYaml();
   bool loadYamlDirScanner();
+  bool loadCache();
+  bool parseCache(const uint8_t *data, uint32_t size, bool apply);
+  void saveCache(const LabelsVector &labels);
 #endif
 };
 
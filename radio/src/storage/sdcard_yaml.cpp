@@ -40,12 +40,19 @@
  #include "storage/eeprom_rlc.h"
 #endif
 
+// Files are read sector by sector: as long as the file position
+// stays aligned, FatFS transfers them straight into this buffer.
+#define YAML_READ_BUFFER_SIZE 512
+static char yamlReadBuffer[YAML_READ_BUFFER_SIZE] __DMA;
+
 const char * readYamlFile(const char* fullpath, const YamlParserCalls* calls, void* parser_ctx, ChecksumResult* checksum_result)
 {
     FIL  file;
     UINT bytes_read;
     UINT total_bytes = 0;
 
+    DEBUG_TIMER_START(debugTimerYamlLoad);
+
     FRESULT result = f_open(&file, fullpath, FA_OPEN_EXISTING | FA_READ);
     if (result != FR_OK) {
         return SDCARD_ERROR(result);
@@ -58,8 +65,8 @@ const char * readYamlFile(const char* fullpath, const YamlParserCalls* calls, vo
     uint16_t file_checksum = 0;
 
     bool first_block = true;
-    char buffer[32];
-    while (f_read(&file, buffer, sizeof(buffer)-1, &bytes_read) == FR_OK) {
+    char* buffer = yamlReadBuffer;
+    while (f_read(&file, buffer, YAML_READ_BUFFER_SIZE, &bytes_read) == FR_OK) {
       if (bytes_read == 0)  // EOF
         break;
       total_bytes += bytes_read;
@@ -70,19 +77,22 @@ const char * readYamlFile(const char* fullpath, const YamlParserCalls* calls, vo
         // The checksum must be first in the first buffer read from file
         first_block = false;
         const char *skipValue = "checksum: ";
-        if(strncmp(buffer, skipValue, strlen(skipValue)) == 0) {
+        if(bytes_read > strlen(skipValue) &&
+           strncmp(buffer, skipValue, strlen(skipValue)) == 0) {
           skip = 10;
           char* startPos = buffer + strlen(skipValue);
           char* endPos = startPos;
           // Advance through the value
           while((*endPos != '\r') && (*endPos != '\n')) {
-            if (endPos > buffer + bytes_read) {
+            endPos++;
+            if (endPos >= buffer + bytes_read) {
+              f_close(&file);
               return SDCARD_ERROR(	FR_INT_ERR );
             }
-            endPos++;
           }
           // Skip trailing newline
-          while((*endPos == '\r') || (*endPos == '\n')) {
+          while((endPos < buffer + bytes_read) &&
+                ((*endPos == '\r') || (*endPos == '\n'))) {
             *endPos = 0;
             endPos++;
           }
@@ -119,6 +129,12 @@ const char * readYamlFile(const char* fullpath, const YamlParserCalls* calls, vo
       }
     }
 
+#if defined(DEBUG_TIMERS)
+    DEBUG_TIMER_STOP(debugTimerYamlLoad);
+    TRACE("YAML: %s loaded in %luus (%u bytes)", fullpath,
+          debugTimers[debugTimerYamlLoad].getLast(), total_bytes);
+#endif
+
     return NULL;
 }
 
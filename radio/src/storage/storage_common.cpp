@@ -23,6 +23,7 @@
 #include "timers_driver.h"
 #include "tasks/mixer_task.h"
 #include "mixes.h"
+#include "switches.h"
 
 #if defined(USBJ_EX)
 #include "usb_joystick.h"
@@ -48,6 +49,21 @@ void storageDirty(uint8_t msk)
   storageDirtyMsk |= msk;
   storageDirtyTime10ms = get_tmr10ms();
 
+  // model data may have changed: smooth curves have to be compiled
+  // again, the telemetry sensors indexed again, and the mix lines and
+  // logical switches ordered again
+  if (msk & EE_MODEL) {
+    invalidateCurves();
+    invalidateTelemetryIndex();
+    invalidateMixerProgram();
+    invalidateLogicalSwitchesOrder();
+  }
+
+  // and the special / global functions listed again
+  if (msk & (EE_MODEL | EE_GENERAL)) {
+    invalidateFunctionsDispatch();
+  }
+
 #if defined(RTC_BACKUP_RAM)
   rambackupDirtyMsk = storageDirtyMsk;
   rambackupDirtyTime10ms = storageDirtyTime10ms;
@@ -107,6 +123,8 @@ void postRadioSettingsLoad()
       serialSetMode(port_nr, UART_MODE_NONE);
   }
 #endif
+
+  invalidateFunctionsDispatch();
 }
 
 static bool sortMixerLines()
@@ -236,7 +254,11 @@ if(g_model.rssiSource) {
   }
 
   loadCurves();
+  invalidateTelemetryIndex();
   sanitizeMixerLines();
+  invalidateMixerProgram();
+  invalidateLogicalSwitchesOrder();
+  invalidateFunctionsDispatch();
 
 #if defined(GUI)
   if (alarms) {
@@ -1645,7 +1645,11 @@ static void r_customFn(void* user, uint8_t* data, uint32_t bitoffs,
     val++; val_len--;
   }
 
-  if (HAS_REPEAT_PARAM(func)) {
+  if (func == FUNC_LOGS) {
+    // optional high rate period, in 10ms increments
+    CFN_LOGS_HIGH_RATE(cfn) = yaml_str2uint(val, val_len);
+  }
+  else if (HAS_REPEAT_PARAM(func)) {
     if (func == FUNC_PLAY_SCRIPT) {
       if (val_len == 2 && val[0] == '1' && val[1] == 'x')
         CFN_PLAY_REPEAT(cfn) = 1;
@@ -1796,6 +1800,15 @@ static bool w_customFn(void* user, uint8_t* data, uint32_t bitoffs,
   // "0/1"
   if (!wf(opaque,CFN_ACTIVE(cfn) ? "1":"0",1)) return false;
 
+  if (func == FUNC_LOGS && CFN_LOGS_HIGH_RATE(cfn)) {
+    // ","
+    if (!wf(opaque,",",1)) return false;
+
+    // high rate period, in 10ms increments
+    str = yaml_unsigned2str(CFN_LOGS_HIGH_RATE(cfn));
+    if (!wf(opaque, str, strlen(str))) return false;
+  }
+
   if (HAS_REPEAT_PARAM(func)) {
     // ","
     if (!wf(opaque,",",1)) return false;
@@ -749,7 +749,7 @@ static const struct YamlNode struct_TelemetrySensor[] = {
   YAML_UNSIGNED( "logs", 1 ),
   YAML_UNSIGNED( "persistent", 1 ),
   YAML_UNSIGNED( "onlyPositive", 1 ),
-  YAML_PADDING( 1 ),
+  YAML_UNSIGNED( "logsHighRate", 1 ),
   YAML_UNION("cfg", 32, union_anonymous_17_elmts, select_sensor_cfg),
   YAML_END
 };
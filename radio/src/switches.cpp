@@ -64,6 +64,29 @@ CircularBuffer<uint8_t, 8> luaSetStickySwitchBuffer;
 
 #define LS_LAST_VALUE(fm, idx) lswFm[fm].lsw[idx].lastValue
 
+// Evaluation order of the logical switches, a switch coming after the
+// ones it uses so that chains settle in one tick (switches using each
+// other in a loop are kept in the index order). Built again after each
+// model change.
+static uint8_t lswOrder[MAX_LOGICAL_SWITCHES];
+static bool lswOrderBuilt = false;
+
+// Switches which only depend on logical switches coming before them in
+// lswOrder (AND / OR / XOR without delay or duration, and unused
+// switches): they are not evaluated again while those didn't change
+static uint64_t lswPure = 0;
+
+// Flight modes whose switches states are up to date with their inputs,
+// so that pure switches may be skipped
+static uint16_t lswFmEvaluated = 0;
+
+// States of the switches of each flight mode, one bit per switch, so
+// that the changes are found without reading each switch
+static uint64_t lswStates[MAX_FLIGHT_MODES];
+
+static_assert(MAX_LOGICAL_SWITCHES <= 64, "lswPure is too small");
+static_assert(MAX_FLIGHT_MODES <= 16, "lswFmEvaluated is too small");
+
 tmr10ms_t switchesMidposStart[MAX_SWITCHES];
 uint64_t  switchesPos = 0;
 
@@ -663,13 +686,124 @@ uint8_t getXPotPosition(uint8_t idx)
 }
 
 
+void invalidateLogicalSwitchesOrder()
+{
+  lswOrderBuilt = false;
+}
+
+// Returns the logical switches used by a switch source
+static uint64_t getSwitchLswMask(swsrc_t swtch)
+{
+  swtch = abs(swtch);
+  if (swtch >= SWSRC_FIRST_LOGICAL_SWITCH && swtch <= SWSRC_LAST_LOGICAL_SWITCH)
+    return (uint64_t)1 << (swtch - SWSRC_FIRST_LOGICAL_SWITCH);
+  return 0;
+}
+
+static uint64_t getSourceLswMask(mixsrc_t source)
+{
+  if (source >= MIXSRC_FIRST_LOGICAL_SWITCH && source <= MIXSRC_LAST_LOGICAL_SWITCH)
+    return (uint64_t)1 << (source - MIXSRC_FIRST_LOGICAL_SWITCH);
+  return 0;
+}
+
+// Returns the logical switches read when evaluating switch 'idx'
+static uint64_t getLogicalSwitchInputs(uint8_t idx)
+{
+  LogicalSwitchData * ls = lswAddress(idx);
+  if (ls->func == LS_FUNC_NONE)
+    return 0;
+
+  uint64_t inputs = getSwitchLswMask(ls->andsw);
+  switch (lswFamily(ls->func)) {
+    case LS_FAMILY_BOOL:
+      inputs |= getSwitchLswMask(ls->v1) | getSwitchLswMask(ls->v2);
+      break;
+    case LS_FAMILY_OFS:
+    case LS_FAMILY_DIFF:
+      inputs |= getSourceLswMask(ls->v1);
+      break;
+    case LS_FAMILY_COMP:
+      inputs |= getSourceLswMask(ls->v1) | getSourceLswMask(ls->v2);
+      break;
+    default:
+      // timer, sticky and edge switches read their inputs on each tick
+      break;
+  }
+  return inputs;
+}
+
+static bool isLogicalSwitchPure(uint8_t idx)
+{
+  LogicalSwitchData * ls = lswAddress(idx);
+  if (ls->func == LS_FUNC_NONE)
+    return true;
+
+  // a switch using itself may change on each tick
+  if (lswFamily(ls->func) != LS_FAMILY_BOOL || ls->delay || ls->duration ||
+      (getLogicalSwitchInputs(idx) & ((uint64_t)1 << idx)))
+    return false;
+
+  return (ls->v1 == SWSRC_NONE || getSwitchLswMask(ls->v1)) &&
+         (ls->v2 == SWSRC_NONE || getSwitchLswMask(ls->v2)) &&
+         (ls->andsw == SWSRC_NONE || getSwitchLswMask(ls->andsw));
+}
+
+static void buildLogicalSwitchesOrder()
+{
+  uint64_t inputs[MAX_LOGICAL_SWITCHES];
+  for (uint8_t i = 0; i < MAX_LOGICAL_SWITCHES; i++) {
+    // a switch using itself gets its previous state
+    inputs[i] = getLogicalSwitchInputs(i) & ~((uint64_t)1 << i);
+  }
+
+  // the lowest switch whose inputs are all evaluated comes next
+  uint64_t pending = (uint64_t)-1 >> (64 - MAX_LOGICAL_SWITCHES);
+  uint8_t count = 0;
+  lswPure = 0;
+  while (pending) {
+    uint8_t idx = 0;
+    while (idx < MAX_LOGICAL_SWITCHES &&
+           (!(pending & ((uint64_t)1 << idx)) || (inputs[idx] & pending)))
+      idx++;
+
+    if (idx == MAX_LOGICAL_SWITCHES) {
+      // loop: the remaining switches in the index order
+      for (idx = 0; idx < MAX_LOGICAL_SWITCHES; idx++) {
+        if (pending & ((uint64_t)1 << idx))
+          lswOrder[count++] = idx;
+      }
+      break;
+    }
+
+    if (isLogicalSwitchPure(idx))
+      lswPure |= (uint64_t)1 << idx;
+    lswOrder[count++] = idx;
+    pending &= ~((uint64_t)1 << idx);
+  }
+
+  lswOrderBuilt = true;
+  lswFmEvaluated = 0;
+}
+
 /**
   @brief Calculates new state of logical switches for mixerCurrentFlightMode
 */
 void evalLogicalSwitches(bool isCurrentFlightmode)
 {
-  for (unsigned int idx=0; idx<MAX_LOGICAL_SWITCHES; idx++) {
+  if (!lswOrderBuilt)
+    buildLogicalSwitchesOrder();
+
+  uint16_t fmBit = 1 << mixerCurrentFlightMode;
+  uint64_t pure = (lswFmEvaluated & fmBit) ? lswPure : 0;
+  uint64_t changed = 0;
+
+  for (uint8_t idx : lswOrder) {
     LogicalSwitchContext & context = lswFm[mixerCurrentFlightMode].lsw[idx];
+    uint64_t bit = (uint64_t)1 << idx;
+    if ((pure & bit) && !(getLogicalSwitchInputs(idx) & changed))
+      continue;
+
     bool result = getLogicalSwitch(idx);
     if (isCurrentFlightmode) {
       if (result) {
@@ -679,8 +813,18 @@ void evalLogicalSwitches(bool isCurrentFlightmode)
         if (context.state) PLAY_LOGICAL_SWITCH_OFF(idx);
       }
     }
+    if (result != context.state)
+      changed |= bit;
     context.state = result;
   }
+
+  lswStates[mixerCurrentFlightMode] ^= changed;
+  lswFmEvaluated |= fmBit;
+}
+
+uint64_t getLogicalSwitchesStates()
+{
+  return lswStates[mixerCurrentFlightMode];
 }
 
 static inline uint8_t _bits_set(uint8_t val, uint8_t bits)
@@ -1072,6 +1216,9 @@ void logicalSwitchesReset()
   }
 
   luaSetStickySwitchBuffer.clear();
+
+  memset(lswStates, 0, sizeof(lswStates));
+  lswOrderBuilt = false;
 }
 
 getvalue_t convertLswTelemValue(LogicalSwitchData * ls)
@@ -1084,4 +1231,6 @@ getvalue_t convertLswTelemValue(LogicalSwitchData * ls)
 void logicalSwitchesCopyState(uint8_t src, uint8_t dst)
 {
   lswFm[dst] = lswFm[src];
+  lswStates[dst] = lswStates[src];
+  lswFmEvaluated &= ~(1 << dst);
 }
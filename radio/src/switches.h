@@ -44,6 +44,10 @@ int16_t lswTimerValue(delayval_t val);
 void evalLogicalSwitches(bool isCurrentFlightmode=true);
 void logicalSwitchesCopyState(uint8_t src, uint8_t dst);
 void logicalSwitchesReset();
+void invalidateLogicalSwitchesOrder();
+// States of the logical switches of mixerCurrentFlightMode, one bit
+// per switch
+uint64_t getLogicalSwitchesStates();
 void logicalSwitchesTimerTick();
 
 bool isSwitchWarningRequired(uint16_t &bad_pots);
@@ -186,6 +186,19 @@ static int stm32_softserial_rx_get_byte(void* ctx, uint8_t* data)
   return 1;
 }
 
+static int stm32_softserial_rx_copy_rx_buffer(void* ctx, uint8_t* buf, uint32_t len)
+{
+  int res = 0;
+  while (len > 0 && rxWidx != rxRidx) {
+    *buf++ = rxBuffer[rxRidx];
+    rxRidx = (rxRidx + 1) & (rxBufLen - 1);
+    len--;
+    res++;
+  }
+
+  return res;
+}
+
 void stm32_softserial_rx_timer_isr(const stm32_softserial_rx_port* port)
 {
   auto TIMx = port->TIMx;
@@ -233,6 +246,7 @@ const etx_serial_driver_t STM32SoftSerialRxDriver = {
   .enableRx = nullptr,
   .getByte = stm32_softserial_rx_get_byte,
   .getLastByte = nullptr,
+  .copyRxBuffer = stm32_softserial_rx_copy_rx_buffer,
   .clearRxBuffer = stm32_softserial_rx_clear_rx_buffer,
   .getBaudrate = nullptr,
   .setReceiveCb = nullptr,
@@ -619,5 +619,6 @@ void storageInit() {}
 void storageDeInit() {}
 void storagePreMountHook() {}
 bool storageIsPresent() { return true; }
+void storagePeriodicTasks() {}
 
 #endif  // #if defined(SIMU_USE_SDCARD)
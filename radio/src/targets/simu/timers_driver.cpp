@@ -20,7 +20,8 @@
  */
 
 #include "timers_driver.h"
+#include "simpgmspace.h"
 
 void watchdogSuspend(unsigned int) {}
-uint32_t timersGetUsTick() { return 0; }
+uint32_t timersGetUsTick() { return simuTimerMicros(); }
 
@@ -169,7 +169,13 @@ void lcdRefresh()
     lcdInitFinish();
   }
 
+  // only the lines of the pages which changed are sent
+  uint8_t pages = lcdGetChangedPages();
+
   for (uint8_t y=0; y<LCD_H; y++) {
+    if (!(pages & (1 << (y / 8))))
+      continue;
+
     uint8_t * p = &displayBuf[y/2 * LCD_W];
 
     lcdWriteAddress(0, y);
@@ -294,6 +300,7 @@ void lcdInitFinish()
   }
   
   lcdStart();
+  lcdInvalidatePages();
   lcdWriteCommand(0xAF); // dc2=1, IC into exit SLEEP MODE, dc3=1 gray=ON, dc4=1 Green Enhanc mode disabled
   delay_ms(20); // Needed for internal DC-DC converter startup
 }
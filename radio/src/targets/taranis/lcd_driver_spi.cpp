@@ -245,60 +245,88 @@ void lcdRefreshWait()
   WAIT_FOR_DMA_END();
 }
 
-void lcdRefresh(bool wait)
+#if LCD_W == 128
+// Pages still to be sent: the refresh only starts the first one, each
+// of the next ones is started from the DMA interrupt
+static volatile uint8_t lcdPendingPages = 0;
+
+static void lcdSendNextPage()
 {
-  if (!lcdInitFinished) {
-    lcdInitFinish();
-  }
+  uint8_t page = __builtin_ctz(lcdPendingPages);
+  lcdPendingPages &= ~(1 << page);
 
-#if LCD_W == 128
-  uint8_t * p = displayBuf;
-#if defined(LCD_W_OFFSET)
-  lcdWriteCommand(LCD_W_OFFSET);
-#endif
-  for (uint8_t y=0; y < 8; y++, p+=LCD_W) {
 #if defined(SSD1309_LCD)
-    lcdPageSet(y);
-    lcdColumnSet(0);
+  lcdPageSet(page);
+  lcdColumnSet(0);
 #else
-    lcdWriteCommand(0x10); // Column addr 0
-    lcdWriteCommand(0xB0 | y); // Page addr y
+  lcdWriteCommand(0x10); // Column addr 0
+  lcdWriteCommand(0xB0 | page); // Page addr
 #if !defined(LCD_VERTICAL_INVERT)
-    lcdWriteCommand(0x04);
+  lcdWriteCommand(0x04);
 #endif
 #endif
 
-    LCD_NCS_LOW();
-    LCD_A0_HIGH();
-
-    lcd_busy = true;
-    LCD_DMA_Stream->CR &= ~DMA_SxCR_EN; // Disable DMA
-    LCD_DMA->HIFCR = LCD_DMA_FLAGS; // Write ones to clear bits
-    LCD_DMA_Stream->M0AR = (uint32_t)p;
-    LCD_DMA_Stream->CR |= DMA_SxCR_EN | DMA_SxCR_TCIE; // Enable DMA & TC interrupts
-    LCD_SPI->CR2 |= SPI_CR2_TXDMAEN;
+  LCD_NCS_LOW();
+  LCD_A0_HIGH();
 
-    WAIT_FOR_DMA_END();
+  LCD_DMA_Stream->CR &= ~DMA_SxCR_EN; // Disable DMA
+  LCD_DMA->HIFCR = LCD_DMA_FLAGS; // Write ones to clear bits
+  LCD_DMA_Stream->M0AR = (uint32_t)&displayBuf[page * LCD_W];
+  LCD_DMA_Stream->CR |= DMA_SxCR_EN | DMA_SxCR_TCIE; // Enable DMA & TC interrupts
+  LCD_SPI->CR2 |= SPI_CR2_TXDMAEN;
+}
+#endif
 
-    LCD_NCS_HIGH();
-    LCD_A0_HIGH();
+// Only the pages which changed since the previous refresh are sent. With
+// wait=false the transfer runs in the background: the display buffer must
+// not be modified before lcdRefreshWait(), or the changed pages would be
+// torn and never sent again
+void lcdRefresh(bool wait)
+{
+  if (!lcdInitFinished) {
+    lcdInitFinish();
   }
-#else
+
   // Wait if previous DMA transfer still active
   WAIT_FOR_DMA_END();
+
+  uint8_t pages = lcdGetChangedPages();
+  if (!pages) {
+    return;
+  }
+
+#if LCD_W == 128
+#if defined(LCD_W_OFFSET)
+  lcdWriteCommand(LCD_W_OFFSET);
+#endif
+
   lcd_busy = true;
+  lcdPendingPages = pages;
+  lcdSendNextPage();
+#else
+  // the pages from the first to the last changed one are sent at once
+  uint8_t first = __builtin_ctz(pages);
+  uint8_t last = 31 - __builtin_clz(pages);
 
-  lcdWriteAddress(0, 0);
+  lcd_busy = true;
+
+  lcdWriteAddress(0, first * 4); // a RAM row holds 2 lines
 
   LCD_NCS_LOW();
   LCD_A0_HIGH();
 
   LCD_DMA_Stream->CR &= ~DMA_SxCR_EN; // Disable DMA
   LCD_DMA->HIFCR = LCD_DMA_FLAGS; // Write ones to clear bits
+  LCD_DMA_Stream->M0AR = (uint32_t)&displayBuf[first * LCD_PAGE_SIZE];
+  LCD_DMA_Stream->NDTR = (last - first + 1) * LCD_PAGE_SIZE;
 
   LCD_DMA_Stream->CR |= DMA_SxCR_EN | DMA_SxCR_TCIE; // Enable DMA & TC interrupts
   LCD_SPI->CR2 |= SPI_CR2_TXDMAEN;
 #endif
+
+  if (wait) {
+    WAIT_FOR_DMA_END();
+  }
 }
 
 extern "C" void LCD_DMA_Stream_IRQHandler()
@@ -317,6 +345,14 @@ extern "C" void LCD_DMA_Stream_IRQHandler()
     */
   }
   LCD_NCS_HIGH();
+
+#if LCD_W == 128
+  if (lcdPendingPages) {
+    lcdSendNextPage();
+    return;
+  }
+#endif
+
   lcd_busy = false;
 }
 
@@ -405,6 +441,7 @@ void lcdInitFinish()
   }
 
   lcdStart();
+  lcdInvalidatePages();
   lcdWriteCommand(0xAF); // dc2=1, IC into exit SLEEP MODE, dc3=1 gray=ON, dc4=1 Green Enhanc mode disabled
   delay_ms(20); // needed for internal DC-DC converter startup
 }
@@ -415,9 +452,7 @@ void lcdSetRefVolt(uint8_t val)
     lcdInitFinish();
   }
 
-#if LCD_W != 128
   WAIT_FOR_DMA_END();
-#endif
 
   lcdWriteCommand(0x81); // Set Vop
   lcdWriteCommand(val+LCD_CONTRAST_OFFSET); // 0-255
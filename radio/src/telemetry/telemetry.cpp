@@ -168,13 +168,17 @@ void telemetrySetMirrorCb(void* ctx, void (*fct)(void*, uint8_t))
   telemetryMirrorSendByte = fct;
 }
 
-void telemetryMirrorSend(uint8_t data)
+void telemetryMirrorSend(const uint8_t* data, uint32_t len)
 {
   auto _sendByte = telemetryMirrorSendByte;
   auto _ctx = telemetryMirrorSendByteCtx;
 
   if (_sendByte) {
-    _sendByte(_ctx, data);
+    // the mirror port queues single bytes into its TX FIFO,
+    // as 'data' might not outlive a DMA transfer
+    while (len--) {
+      _sendByte(_ctx, *data++);
+    }
   }
 }
 
@@ -240,10 +244,8 @@ static void _poll_frame(void *pvParameter1, uint32_t ulParameter2)
   if (frame_len > 0) {
 
     LOG_TELEMETRY_WRITE_START();
-    for (int i = 0; i < frame_len; i++) {
-      telemetryMirrorSend(frame[i]);
-      LOG_TELEMETRY_WRITE_BYTE(frame[i]);
-    }
+    telemetryMirrorSend(frame, frame_len);
+    LOG_TELEMETRY_WRITE_BUFFER(frame, frame_len);
 
     uint8_t* rxBuffer = getTelemetryRxBuffer(module);
     uint8_t& rxBufferCount = getTelemetryRxBufferCount(module);
@@ -277,27 +279,58 @@ inline bool isBadAntennaDetected()
   return false;
 }
 
+static void processTelemetryBuffer(const etx_proto_driver_t* drv, void* ctx,
+                                   const uint8_t* data, uint32_t len,
+                                   uint8_t* rxBuffer, uint8_t* rxBufferCount)
+{
+  if (drv->processBuffer) {
+    drv->processBuffer(ctx, data, len, rxBuffer, rxBufferCount);
+    return;
+  }
+
+  while (len--) {
+    drv->processData(ctx, *data++, rxBuffer, rxBufferCount);
+  }
+}
+
 static inline void pollTelemetry(uint8_t module, const etx_proto_driver_t* drv, void* ctx)
 {
-  if (!drv || !drv->processData) return;
+  if (!drv || (!drv->processData && !drv->processBuffer)) return;
 
   auto mod_st = (etx_module_state_t*)ctx;
   auto serial_drv = modulePortGetSerialDrv(mod_st->rx);
   auto serial_ctx = modulePortGetCtx(mod_st->rx);
 
-  if (!serial_drv  || !serial_ctx || !serial_drv->getByte)
-    return;
+  if (!serial_drv || !serial_ctx) return;
 
   uint8_t* rxBuffer = getTelemetryRxBuffer(module);
   uint8_t& rxBufferCount = getTelemetryRxBufferCount(module);
 
+  if (serial_drv->copyRxBuffer) {
+    // consume whatever has been received so far in chunks
+    uint8_t chunk[TELEMETRY_RX_PACKET_SIZE];
+    int len = serial_drv->copyRxBuffer(serial_ctx, chunk, sizeof(chunk));
+    if (len > 0) {
+      LOG_TELEMETRY_WRITE_START();
+      do {
+        telemetryMirrorSend(chunk, len);
+        processTelemetryBuffer(drv, ctx, chunk, len, rxBuffer, &rxBufferCount);
+        LOG_TELEMETRY_WRITE_BUFFER(chunk, len);
+      } while ((len = serial_drv->copyRxBuffer(serial_ctx, chunk,
+                                               sizeof(chunk))) > 0);
+    }
+    return;
+  }
+
+  if (!serial_drv->getByte) return;
+
   uint8_t data;
   if (serial_drv->getByte(serial_ctx, &data) > 0) {
     LOG_TELEMETRY_WRITE_START();
     do {
-      telemetryMirrorSend(data);
-      drv->processData(ctx, data, rxBuffer, &rxBufferCount);
-      LOG_TELEMETRY_WRITE_BYTE(data);
+      telemetryMirrorSend(&data, 1);
+      processTelemetryBuffer(drv, ctx, &data, 1, rxBuffer, &rxBufferCount);
+      LOG_TELEMETRY_WRITE_BUFFER(&data, 1);
     } while (serial_drv->getByte(serial_ctx, &data) > 0);
   }
 }
@@ -456,9 +489,24 @@ void logTelemetryWriteStart()
   }
 }
 
-void logTelemetryWriteByte(uint8_t data)
+void logTelemetryWriteBuffer(const uint8_t* data, uint32_t len)
 {
-  f_printf(&g_telemetryFile, " %02X", data);
+  static const char hex[] = "0123456789ABCDEF";
+  char text[3 * 16];
+
+  while (len > 0) {
+    uint32_t count = min<uint32_t>(len, 16);
+    char* s = text;
+    for (uint32_t i = 0; i < count; i++) {
+      *s++ = ' ';
+      *s++ = hex[data[i] >> 4];
+      *s++ = hex[data[i] & 0x0F];
+    }
+    UINT written;
+    f_write(&g_telemetryFile, text, s - text, &written);
+    data += count;
+    len -= count;
+  }
 }
 #endif
 
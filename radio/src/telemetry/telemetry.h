@@ -70,8 +70,8 @@ void telemetrySetGetByte(void* ctx, int (*fct)(void*, uint8_t*));
 // Set telemetry mirror callback
 void telemetrySetMirrorCb(void* ctx, void (*fct)(void*, uint8_t));
 
-// Mirror telemetry byte
-void telemetryMirrorSend(uint8_t data);
+// Mirror received telemetry bytes
+void telemetryMirrorSend(const uint8_t* data, uint32_t len);
 
 void telemetryWakeup();
 void telemetryReset();
@@ -123,6 +123,10 @@ int setTelemetryText(TelemetryProtocol protocol, uint16_t id, uint8_t subId, uin
 void delTelemetryIndex(uint8_t index);
 int availableTelemetryIndex();
 int lastUsedTelemetryIndex();
+void invalidateTelemetryIndex();
+
+// First available sensor with this label, or -1
+int findTelemetrySensor(const char * label, uint8_t len);
 
 int32_t convertTelemetryValue(int32_t value, uint8_t unit, uint8_t prec, uint8_t destUnit, uint8_t destPrec);
 
@@ -143,12 +147,12 @@ rxStatStruct *getRxStatLabels();
 
 #if defined(LOG_TELEMETRY) && !defined(SIMU)
 void logTelemetryWriteStart();
-void logTelemetryWriteByte(uint8_t data);
+void logTelemetryWriteBuffer(const uint8_t* data, uint32_t len);
 #define LOG_TELEMETRY_WRITE_START()    logTelemetryWriteStart()
-#define LOG_TELEMETRY_WRITE_BYTE(data) logTelemetryWriteByte(data)
+#define LOG_TELEMETRY_WRITE_BUFFER(data, len) logTelemetryWriteBuffer(data, len)
 #else
 #define LOG_TELEMETRY_WRITE_START()
-#define LOG_TELEMETRY_WRITE_BYTE(data)
+#define LOG_TELEMETRY_WRITE_BUFFER(data, len)
 #endif
 #define TELEMETRY_OUTPUT_BUFFER_SIZE  64
 
@@ -477,6 +477,7 @@ void delTelemetryIndex(uint8_t index)
 {
   memclear(&g_model.telemetrySensors[index], sizeof(TelemetrySensor));
   telemetryItems[index].clear();
+  invalidateTelemetryIndex();
   storageDirty(EE_MODEL);
 }
 
@@ -502,6 +503,104 @@ int lastUsedTelemetryIndex()
   return -1;
 }
 
+// Custom sensors indexed by (id, subId). The sensors sharing the same
+// bucket are chained in index order, both tables hold index + 1
+#define TELEMETRY_SENSORS_HASH_BITS    6
+#define TELEMETRY_SENSORS_HASH_SIZE    (1 << TELEMETRY_SENSORS_HASH_BITS)
+
+static uint8_t sensorsHash[TELEMETRY_SENSORS_HASH_SIZE];
+static uint8_t sensorsHashNext[MAX_TELEMETRY_SENSORS];
+static bool sensorsHashValid = false;
+
+static_assert(MAX_TELEMETRY_SENSORS < 255, "sensorsHash is too small");
+
+static inline uint8_t getSensorHash(uint16_t id, uint8_t subId)
+{
+  uint16_t key = id ^ ((uint16_t)subId << 8);
+  return (uint16_t)(key * 40503u) >> (16 - TELEMETRY_SENSORS_HASH_BITS);
+}
+
+static void buildTelemetryIndex()
+{
+  // flagged first: a change during the build invalidates it again
+  sensorsHashValid = true;
+
+  memclear(sensorsHash, sizeof(sensorsHash));
+  for (int index = MAX_TELEMETRY_SENSORS - 1; index >= 0; index--) {
+    const TelemetrySensor & telemetrySensor = g_model.telemetrySensors[index];
+    if (telemetrySensor.type == TELEM_TYPE_CUSTOM) {
+      uint8_t hash = getSensorHash(telemetrySensor.id, telemetrySensor.subId);
+      sensorsHashNext[index] = sensorsHash[hash];
+      sensorsHash[hash] = index + 1;
+    }
+  }
+}
+
+// Available sensors indexed by label, chained in index order as well
+#define TELEMETRY_LABELS_HASH_BITS     6
+#define TELEMETRY_LABELS_HASH_SIZE     (1 << TELEMETRY_LABELS_HASH_BITS)
+
+static uint8_t labelsHash[TELEMETRY_LABELS_HASH_SIZE];
+static uint8_t labelsHashNext[MAX_TELEMETRY_SENSORS];
+static bool labelsHashValid = false;
+
+static inline uint8_t getLabelHash(const char * label, uint8_t len)
+{
+  uint16_t key = 0;
+  for (uint8_t i = 0; i < len; i++) {
+    key = key * 31 + (uint8_t)label[i];
+  }
+  return (uint16_t)(key * 40503u) >> (16 - TELEMETRY_LABELS_HASH_BITS);
+}
+
+static void buildTelemetryLabelsIndex()
+{
+  labelsHashValid = true;
+
+  memclear(labelsHash, sizeof(labelsHash));
+  for (int index = MAX_TELEMETRY_SENSORS - 1; index >= 0; index--) {
+    const TelemetrySensor & telemetrySensor = g_model.telemetrySensors[index];
+    if (telemetrySensor.isAvailable()) {
+      uint8_t len = strnlen(telemetrySensor.label, TELEM_LABEL_LEN);
+      uint8_t hash = getLabelHash(telemetrySensor.label, len);
+      labelsHashNext[index] = labelsHash[hash];
+      labelsHash[hash] = index + 1;
+    }
+  }
+}
+
+int findTelemetrySensor(const char * label, uint8_t len)
+{
+  if (len == 0 || len > TELEM_LABEL_LEN) {
+    return -1;
+  }
+
+  if (!labelsHashValid) {
+    buildTelemetryLabelsIndex();
+  }
+
+  uint8_t next = labelsHash[getLabelHash(label, len)];
+  while (next) {
+    int index = next - 1;
+    next = labelsHashNext[index];
+
+    const TelemetrySensor & telemetrySensor = g_model.telemetrySensors[index];
+    if (telemetrySensor.isAvailable() &&
+        strnlen(telemetrySensor.label, TELEM_LABEL_LEN) == len &&
+        !memcmp(telemetrySensor.label, label, len)) {
+      return index;
+    }
+  }
+
+  return -1;
+}
+
+void invalidateTelemetryIndex()
+{
+  sensorsHashValid = false;
+  labelsHashValid = false;
+}
+
 template <class T>
 int setTelemetryValue(TelemetryProtocol protocol, uint16_t id, uint8_t subId,
                       uint8_t instance, T value, uint32_t unit = 0,
@@ -509,7 +608,15 @@ int setTelemetryValue(TelemetryProtocol protocol, uint16_t id, uint8_t subId,
 {
   bool sensorFound = false;
 
-  for (int index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
+  if (!sensorsHashValid) {
+    buildTelemetryIndex();
+  }
+
+  uint8_t next = sensorsHash[getSensorHash(id, subId)];
+  while (next) {
+    int index = next - 1;
+    next = sensorsHashNext[index];
+
     TelemetrySensor &telemetrySensor = g_model.telemetrySensors[index];
 
     if (telemetrySensor.type == TELEM_TYPE_CUSTOM && telemetrySensor.id == id &&
@@ -593,6 +700,7 @@ int setTelemetryValue(TelemetryProtocol protocol, uint16_t id, uint8_t subId,
       default:
         return index;
     }
+    invalidateTelemetryIndex();
     telemetryItems[index].setValue(g_model.telemetrySensors[index], value, unit, prec);
     return index;
   }
@@ -0,0 +1,323 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <math.h>
+#include <vector>
+
+#include "gtests.h"
+#include "audio_mix.h"
+
+// Reference: the same Kaiser windowed-sinc, evaluated in double
+// precision at the exact fractional position
+static double besselI0(double x)
+{
+  double sum = 1, term = 1;
+  for (int k = 1; k < 40; k++) {
+    term *= (x / 2) * (x / 2) / (k * k);
+    sum += term;
+  }
+  return sum;
+}
+
+static double referenceTap(double t)
+{
+  const double fc = 0.45, beta = 6.0;
+  double x = 2 * fc * t;
+  double sinc = (x == 0) ? 1 : sin(M_PI * x) / (M_PI * x);
+  double w = t / (AUDIO_RESAMPLER_TAPS / 2);
+  return 2 * fc * sinc * besselI0(beta * sqrt(std::max(0.0, 1 - w * w))) /
+         besselI0(beta);
+}
+
+static double referenceSample(const std::vector<int16_t> & in, double x)
+{
+  int index = (int)x;
+  double frac = x - index;
+  double sum = 0, norm = 0;
+  for (int j = 0; j < AUDIO_RESAMPLER_TAPS; j++) {
+    double h = referenceTap(j - (AUDIO_RESAMPLER_TAPS / 2 - 1) - frac);
+    sum += in[index + j] * h;
+    norm += h;
+  }
+  return sum / norm;
+}
+
+// Resamples a 1kHz sine, one audio buffer at a time, as WavContext does
+static void checkResampler(uint32_t freq)
+{
+  std::vector<int16_t> in(freq / 4);
+  for (size_t i = 0; i < in.size(); i++) {
+    in[i] = 16000 * sin(2 * M_PI * 1000 * i / freq);
+  }
+
+  AudioResampler resampler;
+  resampler.reset(freq);
+
+  std::vector<int32_t> out;
+  int16_t pcm[AUDIO_RESAMPLER_TAPS + 2 * AUDIO_BUFFER_SIZE];
+  audio_data_t buffer[AUDIO_BUFFER_SIZE];
+  size_t read = 0;
+
+  while (read < in.size()) {
+    uint32_t count = std::min<size_t>(resampler.input(AUDIO_BUFFER_SIZE),
+                                      in.size() - read);
+    memcpy(pcm + AUDIO_RESAMPLER_TAPS, &in[read], count * sizeof(int16_t));
+    read += count;
+
+    for (int i = 0; i < AUDIO_BUFFER_SIZE; i++) {
+      buffer[i] = AUDIO_DATA_SILENCE;
+    }
+    audio_data_t * end = resampler.mix(buffer, AUDIO_BUFFER_SIZE,
+                                       pcm + AUDIO_RESAMPLER_TAPS, count,
+                                       16 - AUDIO_BITS_PER_SAMPLE);
+    for (audio_data_t * sample = buffer; sample < end; sample++) {
+      out.push_back((int32_t)*sample - AUDIO_DATA_SILENCE);
+    }
+  }
+
+  // the last source samples are not reached by the filter
+  double expected = (double)in.size() * AUDIO_SAMPLE_RATE / freq;
+  EXPECT_NEAR(expected, out.size(), 2.0 * AUDIO_RESAMPLER_TAPS * AUDIO_SAMPLE_RATE / freq)
+      << "freq " << freq;
+
+  uint32_t step = audioResamplerStep(freq);
+  double maxError = 0;
+  for (size_t k = 0; k < out.size(); k++) {
+    double x = (double)k * step / (1 << AUDIO_RESAMPLER_POS_SHIFT);
+    double error = fabs(out[k] - referenceSample(in, x));
+    maxError = std::max(maxError, error);
+  }
+  // phase quantization and Q14 taps: less than 0.3% of the amplitude
+  EXPECT_LT(maxError, 48) << "freq " << freq;
+}
+
+TEST(Audio, resampler)
+{
+  checkResampler(8000);
+  checkResampler(11025);
+  checkResampler(16000);
+  checkResampler(22050);
+  checkResampler(44100);
+  checkResampler(48000);
+}
+
+TEST(Audio, resamplerKeepsRate)
+{
+  // a 8kHz source produces 4 samples per source sample
+  AudioResampler resampler;
+  resampler.reset(8000);
+  EXPECT_EQ((uint32_t)(AUDIO_BUFFER_SIZE / 4 + AUDIO_RESAMPLER_TAPS - 1),
+            resampler.input(AUDIO_BUFFER_SIZE));
+}
+
+// Reference IMA-ADPCM encoder (mono), as done by the sound pack converter
+static std::vector<uint8_t> encodeAdpcm(const std::vector<int16_t> & in,
+                                        uint16_t blockSize)
+{
+  std::vector<uint8_t> out;
+  uint32_t samplesPerBlock = (blockSize - AUDIO_ADPCM_HEADER_SIZE) * 2 + 1;
+  uint8_t index = 0;
+
+  for (size_t start = 0; start < in.size(); start += samplesPerBlock) {
+    // the step index is carried over from the previous block
+    int32_t predictor = in[start];
+    out.push_back(predictor & 0xFF);
+    out.push_back((predictor >> 8) & 0xFF);
+    out.push_back(index);
+    out.push_back(0);
+
+    uint8_t byte = 0;
+    for (uint32_t i = 1; i < samplesPerBlock; i++) {
+      int32_t sample = start + i < in.size() ? in[start + i] : 0;
+      int32_t diff = sample - predictor;
+      int32_t step = adpcmSteps[index];
+      uint8_t code = 0;
+      if (diff < 0) {
+        code = 8;
+        diff = -diff;
+      }
+      if (diff >= step) { code |= 4; diff -= step; }
+      if (diff >= step / 2) { code |= 2; diff -= step / 2; }
+      if (diff >= step / 4) { code |= 1; }
+      audioAdpcmDecode(code, predictor, index);
+      if (i & 1) {
+        byte = code;
+      }
+      else {
+        out.push_back(byte | (code << 4));
+      }
+    }
+  }
+  return out;
+}
+
+TEST(Audio, adpcm)
+{
+  std::vector<int16_t> in(8000);
+  for (size_t i = 0; i < in.size(); i++) {
+    in[i] = 16000 * sin(2 * M_PI * 1000 * i / 16000);
+  }
+
+  const uint16_t blockSize = 256;
+  std::vector<uint8_t> encoded = encodeAdpcm(in, blockSize);
+  // 4 bits per sample, plus the block headers
+  EXPECT_LT(encoded.size(), in.size() * 2 / 3.5);
+
+  // decoded in chunks of any size, as read from the file
+  AdpcmDecoder decoder;
+  decoder.reset(blockSize);
+  std::vector<int16_t> out(encoded.size() * 2);
+  uint32_t count = 0;
+  for (size_t pos = 0, chunk = 1; pos < encoded.size(); pos += chunk, chunk = chunk * 3 % 251 + 1) {
+    chunk = std::min(chunk, encoded.size() - pos);
+    count += decoder.decode(&out[count], &encoded[pos], chunk);
+  }
+  ASSERT_GE(count, in.size());
+
+  double signal = 0, noise = 0;
+  for (size_t i = 0; i < in.size(); i++) {
+    signal += (double)in[i] * in[i];
+    noise += (double)(out[i] - in[i]) * (out[i] - in[i]);
+  }
+  // signal to noise ratio of a 4-bit IMA-ADPCM encoding
+  EXPECT_GT(10 * log10(signal / noise), 25.0);
+}
+
+TEST(Audio, toneSaturates)
+{
+  // lowest tone at the highest volume, as evaluated by ToneContext
+  int32_t gain = ((int64_t)AUDIO_GAIN_UNITY * 330 * 330) /
+                 (2 * AUDIO_TONE_MIN_FREQ * AUDIO_TONE_MIN_FREQ);
+  ASSERT_GT(gain, AUDIO_GAIN_MAX);
+
+  audio_data_t buffer[AUDIO_SINE_SIZE];
+  for (auto & sample : buffer) {
+    sample = AUDIO_DATA_SILENCE;
+  }
+  uint32_t phase = audioMixTone(buffer, AUDIO_SINE_SIZE, 0,
+                                1 << AUDIO_PHASE_SHIFT, gain,
+                                16 - AUDIO_BITS_PER_SAMPLE);
+  EXPECT_EQ(0u, phase);
+
+  // a period of the sine, clipped instead of wrapping around
+  int errors = 0;
+  for (int i = 0; i < AUDIO_SINE_SIZE; i++) {
+    int32_t sine = sineValues[i];
+    int32_t sample = (int32_t)buffer[i] - AUDIO_DATA_SILENCE;
+    if (sine >= 2048) {
+      errors += buffer[i] != AUDIO_DATA_MAX;
+    } else if (sine <= -2048) {
+      errors += buffer[i] != AUDIO_DATA_MIN;
+    } else {
+      errors += (sine > 0 && sample < 0) || (sine < 0 && sample > 0);
+    }
+  }
+  EXPECT_EQ(0, errors);
+}
+
+static PromptCacheHandle addPrompt(PromptCache & cache, const char * filename,
+                                   uint32_t size, uint8_t seed)
+{
+  PromptFormat format = {1, 0, AUDIO_SAMPLE_RATE, size};
+  PromptCacheHandle handle = cache.create(filename, format);
+  std::vector<uint8_t> data(size);
+  for (uint32_t i = 0; i < size; i++) {
+    data[i] = seed + i * 7;
+  }
+  // appended in chunks, as read while the prompt is played
+  for (uint32_t pos = 0; pos < size && handle.valid(); pos += 640) {
+    cache.append(handle, &data[pos], std::min<uint32_t>(640, size - pos));
+  }
+  return handle;
+}
+
+static bool checkPrompt(PromptCache & cache, const char * filename,
+                        uint32_t size, uint8_t seed)
+{
+  PromptCacheHandle handle = cache.find(filename);
+  if (!handle.valid() || cache.getFormat(handle).size != size) return false;
+  std::vector<uint8_t> data(size);
+  uint32_t read = 0;
+  while (read < size) {
+    uint32_t count = cache.read(handle, read, &data[read], 500);
+    if (count == 0) return false;
+    read += count;
+  }
+  for (uint32_t i = 0; i < size; i++) {
+    if (data[i] != (uint8_t)(seed + i * 7)) return false;
+  }
+  return true;
+}
+
+TEST(PromptCache, fillAndFind)
+{
+  static uint8_t pool[8 * PROMPT_CACHE_BLOCK_SIZE];
+  PromptCache cache;
+  cache.initialize(pool, sizeof(pool));
+
+  EXPECT_FALSE(cache.find("/SOUNDS/en/0001.wav").valid());
+  PromptFormat format = {1, 0, AUDIO_SAMPLE_RATE, 5000};
+  PromptCacheHandle handle = cache.create("/SOUNDS/en/0001.wav", format);
+  ASSERT_TRUE(handle.valid());
+  // not available until complete
+  uint8_t data[100] = {};
+  cache.append(handle, data, sizeof(data));
+  EXPECT_FALSE(cache.find("/SOUNDS/en/0001.wav").valid());
+  cache.abort(handle);
+
+  addPrompt(cache, "/SOUNDS/en/0001.wav", 5000, 1);
+  EXPECT_TRUE(checkPrompt(cache, "/SOUNDS/en/0001.wav", 5000, 1));
+  EXPECT_EQ(1u, cache.getStats().noInsertions);
+  EXPECT_EQ(2u, cache.getStats().noMisses);
+  EXPECT_EQ(1u, cache.getStats().noHits);
+
+  // too long for the pool
+  format.size = 9 * PROMPT_CACHE_BLOCK_SIZE;
+  EXPECT_FALSE(cache.create("/SOUNDS/en/long.wav", format).valid());
+}
+
+TEST(PromptCache, leastRecentlyUsedEviction)
+{
+  static uint8_t pool[7 * PROMPT_CACHE_BLOCK_SIZE];
+  PromptCache cache;
+  cache.initialize(pool, sizeof(pool));
+
+  const uint32_t size = 2 * PROMPT_CACHE_BLOCK_SIZE + 10;  // 3 blocks
+  addPrompt(cache, "a.wav", size, 1);
+  addPrompt(cache, "b.wav", size, 2);
+  PromptCacheHandle a = cache.find("a.wav");
+  PromptCacheHandle b = cache.find("b.wav");
+  ASSERT_TRUE(a.valid());
+  ASSERT_TRUE(b.valid());
+
+  // a is the most recently used: b is evicted
+  cache.find("a.wav");
+  addPrompt(cache, "c.wav", size, 3);
+  EXPECT_EQ(1u, cache.getStats().noEvictions);
+  EXPECT_TRUE(checkPrompt(cache, "a.wav", size, 1));
+  EXPECT_TRUE(checkPrompt(cache, "c.wav", size, 3));
+  EXPECT_FALSE(cache.find("b.wav").valid());
+
+  // the handle on the evicted prompt is stale
+  uint8_t data[16];
+  EXPECT_EQ(0u, cache.read(b, 0, data, sizeof(data)));
+  EXPECT_EQ(16u, cache.read(a, 0, data, sizeof(data)));
+}
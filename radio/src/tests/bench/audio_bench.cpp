@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "bench.h"
+#include "audio_mix.h"
+
+// Reference kernels: float phase and volume, one clamp per sample,
+// as the audio contexts used to do
+static inline void refMixSample(audio_data_t * result, int sample,
+                                unsigned int fade)
+{
+  *result = limit(AUDIO_DATA_MIN,
+                  *result + ((sample >> fade) >> (16 - AUDIO_BITS_PER_SAMPLE)),
+                  AUDIO_DATA_MAX);
+}
+
+static float refMixTone(audio_data_t * data, int points, float idx,
+                        float step, float volume, unsigned int fade)
+{
+  for (int i = 0; i < points; i++) {
+    int16_t sample = sineValues[int(idx)] * volume;
+    refMixSample(&data[i], sample, fade);
+    idx += step;
+    if ((unsigned int)idx >= AUDIO_SINE_SIZE)
+      idx -= AUDIO_SINE_SIZE;
+  }
+  return idx;
+}
+
+static void refMixWav(audio_data_t * data, const int16_t * pcm, int count,
+                      uint8_t ratio, unsigned int fade)
+{
+  for (int i = 0; i < count; i++) {
+    for (uint8_t j = 0; j < ratio; j++) {
+      refMixSample(data++, pcm[i], fade);
+    }
+  }
+}
+
+static void refScaleSamples(audio_data_t * data, int count, int volume)
+{
+  for (int i = 0; i < count; i++) {
+    int32_t sample = (int32_t)((uint32_t)data[i] - AUDIO_DATA_SILENCE);
+    data[i] = (int16_t)(((sample * volume) / VOLUME_LEVEL_MAX) +
+                        AUDIO_DATA_SILENCE);
+  }
+}
+
+static audio_data_t refBuffer[AUDIO_BUFFER_SIZE];
+static audio_data_t buffer[AUDIO_BUFFER_SIZE];
+static int16_t pcm[AUDIO_BUFFER_SIZE];
+
+static void clearBuffer(audio_data_t * data)
+{
+  for (int i = 0; i < AUDIO_BUFFER_SIZE; i++) {
+    data[i] = AUDIO_DATA_SILENCE;
+  }
+}
+
+static uint32_t maxDiff()
+{
+  uint32_t result = 0;
+  for (int i = 0; i < AUDIO_BUFFER_SIZE; i++) {
+    uint32_t diff = abs((int)refBuffer[i] - (int)buffer[i]);
+    if (diff > result) result = diff;
+  }
+  return result;
+}
+
+static void reportAudio(BenchReport & report, const char * subject,
+                        uint32_t samples, double refElapsed, double elapsed,
+                        uint32_t diff)
+{
+  report.begin("audio", subject);
+  report.add("samples", samples);
+  if (refElapsed > 0) {
+    report.add("msamples_per_s_ref", samples * 1000.0 / refElapsed);
+  }
+  report.add("msamples_per_s", samples * 1000.0 / elapsed);
+  report.add("max_diff", diff);
+  report.end();
+}
+
+// A tone, or the vario whose frequency changes on every buffer
+static void audioBenchTone(const BenchOptions & options, BenchReport & report,
+                           const char * subject, bool vario)
+{
+  uint32_t iterations = options.iterations;
+  uint32_t diff = 0;
+
+  float idx = 0;
+  BenchClock refClock;
+  for (uint32_t it = 0; it < iterations; it++) {
+    clearBuffer(refBuffer);
+    int freq = vario ? 600 + (it % 100) * 10 : BEEP_DEFAULT_FREQ;
+    float step = limit<float>(1, float(freq) * (float(AUDIO_SINE_SIZE) / float(AUDIO_SAMPLE_RATE)), 512);
+    idx = refMixTone(refBuffer, AUDIO_BUFFER_SIZE, idx, step, 1.0f / 6, 1);
+  }
+  double refElapsed = refClock.elapsedNs();
+
+  uint32_t phase = 0;
+  BenchClock clock;
+  for (uint32_t it = 0; it < iterations; it++) {
+    clearBuffer(buffer);
+    int freq = vario ? 600 + (it % 100) * 10 : BEEP_DEFAULT_FREQ;
+    phase = audioMixTone(buffer, AUDIO_BUFFER_SIZE, phase, audioPhaseStep(freq),
+                         AUDIO_GAIN_UNITY / 6, 1 + 16 - AUDIO_BITS_PER_SAMPLE);
+  }
+  double elapsed = clock.elapsedNs();
+
+  // same phase on both sides to compare the samples
+  clearBuffer(refBuffer);
+  clearBuffer(buffer);
+  float step = float(BEEP_DEFAULT_FREQ) * (float(AUDIO_SINE_SIZE) / float(AUDIO_SAMPLE_RATE));
+  refMixTone(refBuffer, AUDIO_BUFFER_SIZE, 0, step, 1.0f / 6, 1);
+  audioMixTone(buffer, AUDIO_BUFFER_SIZE, 0, audioPhaseStep(BEEP_DEFAULT_FREQ),
+               AUDIO_GAIN_UNITY / 6, 1 + 16 - AUDIO_BITS_PER_SAMPLE);
+  diff = maxDiff();
+
+  reportAudio(report, subject, iterations * AUDIO_BUFFER_SIZE, refElapsed,
+              elapsed, diff);
+}
+
+// 32kHz PCM files
+static void audioBenchWav(const BenchOptions & options, BenchReport & report)
+{
+  uint32_t iterations = options.iterations;
+
+  for (int i = 0; i < AUDIO_BUFFER_SIZE; i++) {
+    pcm[i] = sineValues[(i * 37) % AUDIO_SINE_SIZE];
+  }
+
+  BenchClock refClock;
+  for (uint32_t it = 0; it < iterations; it++) {
+    clearBuffer(refBuffer);
+    refMixWav(refBuffer, pcm, AUDIO_BUFFER_SIZE, 1, 2);
+  }
+  double refElapsed = refClock.elapsedNs();
+
+  BenchClock clock;
+  for (uint32_t it = 0; it < iterations; it++) {
+    clearBuffer(buffer);
+    audioMixSamples(buffer, pcm, AUDIO_BUFFER_SIZE, 2 + 16 - AUDIO_BITS_PER_SAMPLE);
+  }
+  double elapsed = clock.elapsedNs();
+
+  reportAudio(report, "wav_32k", iterations * AUDIO_BUFFER_SIZE, refElapsed,
+              elapsed, maxDiff());
+}
+
+// Other rates: the resampler, compared to the former sample
+// repetition when the rate divides AUDIO_SAMPLE_RATE
+static void audioBenchResampler(const BenchOptions & options,
+                                BenchReport & report, const char * subject,
+                                uint32_t freq)
+{
+  static int16_t source[AUDIO_RESAMPLER_TAPS + 2 * AUDIO_BUFFER_SIZE];
+  uint32_t iterations = options.iterations;
+  uint8_t ratio = AUDIO_SAMPLE_RATE / freq;
+  double refElapsed = 0;
+
+  for (unsigned i = 0; i < DIM(source); i++) {
+    source[i] = sineValues[(i * 37) % AUDIO_SINE_SIZE];
+  }
+
+  if (ratio * freq == AUDIO_SAMPLE_RATE) {
+    BenchClock refClock;
+    for (uint32_t it = 0; it < iterations; it++) {
+      clearBuffer(refBuffer);
+      refMixWav(refBuffer, source, AUDIO_BUFFER_SIZE / ratio, ratio, 2);
+    }
+    refElapsed = refClock.elapsedNs();
+  }
+
+  AudioResampler resampler;
+  resampler.reset(freq);
+  uint32_t samples = 0;
+
+  BenchClock clock;
+  for (uint32_t it = 0; it < iterations; it++) {
+    clearBuffer(buffer);
+    uint32_t count = resampler.input(AUDIO_BUFFER_SIZE);
+    audio_data_t * end = resampler.mix(buffer, AUDIO_BUFFER_SIZE,
+                                       source + AUDIO_RESAMPLER_TAPS, count,
+                                       2 + 16 - AUDIO_BITS_PER_SAMPLE);
+    samples += end - buffer;
+  }
+  double elapsed = clock.elapsedNs();
+
+  reportAudio(report, subject, samples, refElapsed, elapsed, 0);
+}
+
+// IMA-ADPCM prompts at AUDIO_SAMPLE_RATE: bytes read from the SD card
+// for one audio buffer, compared to PCM, and decoding + mixing cost
+#define BENCH_ADPCM_BLOCK_SIZE  1024
+
+static void audioBenchAdpcm(const BenchOptions & options, BenchReport & report)
+{
+  static uint8_t codes[AUDIO_BUFFER_SIZE / 2];
+  static int16_t decoded[AUDIO_BUFFER_SIZE];
+  uint32_t iterations = options.iterations;
+  uint32_t seed = 12345;
+
+  for (unsigned i = 0; i < DIM(codes); i++) {
+    seed = seed * 1103515245 + 12345;
+    codes[i] = seed >> 16;
+  }
+
+  AdpcmDecoder decoder;
+  decoder.reset(BENCH_ADPCM_BLOCK_SIZE);
+  uint32_t samples = 0;
+
+  BenchClock clock;
+  for (uint32_t it = 0; it < iterations; it++) {
+    clearBuffer(buffer);
+    uint32_t count = decoder.decode(decoded, codes, sizeof(codes));
+    samples += audioMixSamples(buffer, decoded, count,
+                               2 + 16 - AUDIO_BITS_PER_SAMPLE) - buffer;
+  }
+  double elapsed = clock.elapsedNs();
+
+  report.begin("audio", "adpcm");
+  report.add("samples", samples);
+  report.add("sd_bytes_per_buffer_pcm", (uint32_t)(AUDIO_BUFFER_SIZE * 2));
+  report.add("sd_bytes_per_buffer", (uint32_t)sizeof(codes));
+  report.add("sd_read_reduction", 100.0 - sizeof(codes) * 100.0 / (AUDIO_BUFFER_SIZE * 2));
+  report.add("samples_per_buffer", samples / (double)iterations);
+  report.add("ns_per_buffer", elapsed / iterations);
+  report.add("msamples_per_s", samples * 1000.0 / elapsed);
+  report.end();
+}
+
+static void audioBenchVolume(const BenchOptions & options, BenchReport & report)
+{
+  static audio_data_t mixed[AUDIO_BUFFER_SIZE];
+  uint32_t iterations = options.iterations;
+  int volume = VOLUME_LEVEL_MAX / 3;
+
+  clearBuffer(mixed);
+  refMixTone(mixed, AUDIO_BUFFER_SIZE, 0, 70.4f, 1.0f / 2, 0);
+
+  BenchClock refClock;
+  for (uint32_t it = 0; it < iterations; it++) {
+    memcpy(refBuffer, mixed, sizeof(mixed));
+    refScaleSamples(refBuffer, AUDIO_BUFFER_SIZE, volume);
+  }
+  double refElapsed = refClock.elapsedNs();
+
+  BenchClock clock;
+  for (uint32_t it = 0; it < iterations; it++) {
+    memcpy(buffer, mixed, sizeof(mixed));
+    audioScaleSamples(buffer, AUDIO_BUFFER_SIZE,
+                      (volume << 15) / VOLUME_LEVEL_MAX);
+  }
+  double elapsed = clock.elapsedNs();
+
+  reportAudio(report, "software_volume", iterations * AUDIO_BUFFER_SIZE,
+              refElapsed, elapsed, maxDiff());
+}
+
+// Mixing kernels of the tone, vario and WAV contexts, compared
+// to the former float / per-sample / sample repetition implementations
+BENCH(audio)
+{
+  audioBenchTone(options, report, "tone", false);
+  audioBenchTone(options, report, "vario", true);
+  audioBenchWav(options, report);
+  audioBenchResampler(options, report, "wav_8k", 8000);
+  audioBenchResampler(options, report, "wav_16k", 16000);
+  audioBenchResampler(options, report, "wav_22k", 22050);
+  audioBenchResampler(options, report, "wav_44k", 44100);
+  audioBenchAdpcm(options, report);
+  audioBenchVolume(options, report);
+}
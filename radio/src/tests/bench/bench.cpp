@@ -0,0 +1,281 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "hal/adc_driver.h"
+#include "hal/switch_driver.h"
+#include "stamp.h"
+
+#if defined(_WIN32)
+  #define NULL_DEVICE "NUL"
+#else
+  #define NULL_DEVICE "/dev/null"
+#endif
+
+BenchCase * BenchCase::first = nullptr;
+
+BenchCase::BenchCase(const char * name, BenchFunction func):
+  name(name),
+  func(func),
+  next(nullptr)
+{
+  // keep the registration order
+  BenchCase ** last = &first;
+  while (*last) last = &(*last)->next;
+  *last = this;
+}
+
+void BenchReport::addKey(const char * key)
+{
+  fprintf(out, "%s\"%s\":", count++ ? "," : "", key);
+}
+
+void BenchReport::begin(const char * bench, const char * subject)
+{
+  count = 0;
+  fprintf(out, "{");
+  add("bench", bench);
+  add("subject", subject);
+  add("target", FLAVOUR);
+  add("version", VERSION);
+  add("git", GIT_STR);
+}
+
+void BenchReport::add(const char * key, double value)
+{
+  addKey(key);
+  fprintf(out, "%.1f", value);
+}
+
+void BenchReport::add(const char * key, uint32_t value)
+{
+  addKey(key);
+  fprintf(out, "%u", value);
+}
+
+void BenchReport::add(const char * key, const char * value)
+{
+  addKey(key);
+  fputc('"', out);
+  for (const char * c = value; *c; c++) {
+    if (*c == '\n') {
+      fputs("\\n", out);
+      continue;
+    }
+    if (*c == '"' || *c == '\\') fputc('\\', out);
+    fputc(*c, out);
+  }
+  fputc('"', out);
+}
+
+// a benchmark which could not run fails the whole run
+void BenchReport::error(const char * message)
+{
+  add("error", message);
+  errors++;
+}
+
+void BenchReport::end()
+{
+  fprintf(out, "}\n");
+  fflush(out);
+}
+
+void benchForEachFile(const char * path, const char * ext,
+                      void (*func)(const char * filename, void * ctx),
+                      void * ctx)
+{
+  DIR dir;
+  FILINFO fno;
+
+  if (f_opendir(&dir, path) != FR_OK)
+    return;
+
+  while (f_readdir(&dir, &fno) == FR_OK && fno.fname[0] != '\0') {
+    if (fno.fattrib & AM_DIR)
+      continue;
+    const char * fext = strrchr(fno.fname, '.');
+    if (fext && !strcasecmp(fext, ext)) {
+      func(fno.fname, ctx);
+    }
+  }
+
+  f_closedir(&dir);
+}
+
+extern uint8_t s_mixer_first_run_done;
+
+const char * benchLoadModel(const char * path, const char * filename)
+{
+  preModelLoad();
+
+  const char * error = readModel(filename, (uint8_t *)&g_model,
+                                 sizeof(g_model), path);
+  if (error) {
+    return error;
+  }
+
+  postModelLoad(false);
+
+  // start the mixer from scratch
+  s_mixer_first_run_done = false;
+  lastFlightMode = 255;
+  logicalSwitchesReset();
+
+  return nullptr;
+}
+
+static uint16_t benchAnalogs[MAX_ANALOG_INPUTS];
+
+uint16_t simu_get_analog(uint8_t idx)
+{
+  return benchAnalogs[idx];
+}
+
+void benchSetAnalog(uint8_t idx, uint16_t value)
+{
+  benchAnalogs[idx] = value;
+}
+
+// Triangle wave over the full 12 bits ADC range
+static uint16_t triangle(uint32_t t, uint32_t period)
+{
+  uint32_t phase = t % period;
+  uint32_t half = period / 2;
+  if (phase >= half) phase = period - phase;
+  return (phase * 4095) / half;
+}
+
+void benchSweepInputs(uint32_t iteration)
+{
+  // each analog gets its own period, so that
+  // all combinations of positions are visited
+  auto max_analogs = adcGetInputOffset(ADC_INPUT_VBAT);
+  for (uint8_t i = 0; i < max_analogs; i++) {
+    benchSetAnalog(i, triangle(iteration, 250 + 37 * i));
+  }
+
+  // switches move much slower, to trigger flight mode
+  // changes (and fades) at a realistic rate
+  auto max_switches = switchGetMaxSwitches();
+  for (uint8_t i = 0; i < max_switches; i++) {
+    uint32_t period = 1500 + 400 * i;
+    int8_t pos = ((iteration / period) % 3) - 1;
+    simuSetSwitch(i, pos);
+  }
+}
+
+void benchAdvanceTime(uint32_t us)
+{
+  static uint32_t remainder = 0;
+  remainder += us;
+  g_tmr10ms += remainder / 10000;
+  remainder %= 10000;
+}
+
+static void usage(const char * name)
+{
+  fprintf(stderr,
+          "Usage: %s [options]\n"
+          "  -n, --iterations N   iterations per benchmark (default 20000)\n"
+          "  -f, --filter NAME    only run benchmarks whose name contains NAME\n"
+          "  -d, --data PATH      SD card root with the benchmark data\n"
+          "  -o, --output FILE    write the results to FILE (default stdout)\n"
+          "  -l, --list           list the benchmarks\n"
+          "  -v, --verbose        keep the firmware traces\n",
+          name);
+}
+
+int main(int argc, char ** argv)
+{
+  BenchOptions options = { 20000, nullptr, BENCH_DATA_PATH };
+  const char * output = nullptr;
+  bool verbose = false;
+
+  for (int i = 1; i < argc; i++) {
+    const char * arg = argv[i];
+    bool hasValue = (i + 1 < argc);
+    if ((!strcmp(arg, "-n") || !strcmp(arg, "--iterations")) && hasValue) {
+      options.iterations = max<uint32_t>(1, strtoul(argv[++i], nullptr, 10));
+    }
+    else if ((!strcmp(arg, "-f") || !strcmp(arg, "--filter")) && hasValue) {
+      options.filter = argv[++i];
+    }
+    else if ((!strcmp(arg, "-d") || !strcmp(arg, "--data")) && hasValue) {
+      options.dataPath = argv[++i];
+    }
+    else if ((!strcmp(arg, "-o") || !strcmp(arg, "--output")) && hasValue) {
+      output = argv[++i];
+    }
+    else if (!strcmp(arg, "-l") || !strcmp(arg, "--list")) {
+      for (auto bench = BenchCase::first; bench; bench = bench->next)
+        printf("%s\n", bench->name);
+      return 0;
+    }
+    else if (!strcmp(arg, "-v") || !strcmp(arg, "--verbose")) {
+      verbose = true;
+    }
+    else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  FILE * out;
+  if (output) {
+    out = fopen(output, "w");
+    if (!out) {
+      fprintf(stderr, "Cannot open %s\n", output);
+      return 1;
+    }
+  }
+  else {
+    out = fdopen(dup(fileno(stdout)), "w");
+  }
+
+  // firmware traces go to stdout, they would mix with the results
+  if (!verbose && !freopen(NULL_DEVICE, "w", stdout)) {
+    fprintf(stderr, "Cannot silence traces\n");
+  }
+
+  simuInit();
+  simuFatfsSetPaths(options.dataPath, nullptr);
+#if !defined(COLORLCD)
+  menuLevel = 0;
+#endif
+  generalDefault();
+  g_eeGeneral.templateSetup = 0;
+
+  BenchReport report(out);
+  for (auto bench = BenchCase::first; bench; bench = bench->next) {
+    if (options.filter && !strstr(bench->name, options.filter))
+      continue;
+    fprintf(stderr, "Running %s...\n", bench->name);
+    bench->func(options, report);
+  }
+
+  fclose(out);
+  return report.errorCount() ? 1 : 0;
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <chrono>
+
+#define SWAP_DEFINED
+#include "opentx.h"
+#include "switches.h"
+
+struct BenchOptions {
+  uint32_t iterations;
+  const char * filter;
+  const char * dataPath;
+};
+
+// Results are written as one JSON object per line, so that
+// they can easily be collected and compared across commits
+class BenchReport
+{
+  public:
+    explicit BenchReport(FILE * out) : out(out), count(0), errors(0) {}
+
+    void begin(const char * bench, const char * subject);
+    void add(const char * key, double value);
+    void add(const char * key, uint32_t value);
+    void add(const char * key, const char * value);
+    void error(const char * message);
+    void end();
+
+    unsigned errorCount() const { return errors; }
+
+  protected:
+    FILE * out;
+    unsigned count;
+    unsigned errors;
+
+    void addKey(const char * key);
+};
+
+// Context passed to the per-file callbacks
+struct BenchContext {
+  const BenchOptions & options;
+  BenchReport & report;
+};
+
+typedef void (*BenchFunction)(const BenchOptions & options, BenchReport & report);
+
+class BenchCase
+{
+  public:
+    BenchCase(const char * name, BenchFunction func);
+
+    const char * name;
+    BenchFunction func;
+    BenchCase * next;
+
+    static BenchCase * first;
+};
+
+#define BENCH(name)                                                          \
+  static void bench_##name(const BenchOptions & options, BenchReport & report); \
+  static BenchCase _bench_case_##name(#name, bench_##name);                  \
+  static void bench_##name(const BenchOptions & options, BenchReport & report)
+
+class BenchClock
+{
+  public:
+    BenchClock() : start(std::chrono::steady_clock::now()) {}
+
+    double elapsedNs() const
+    {
+      auto now = std::chrono::steady_clock::now();
+      return std::chrono::duration<double, std::nano>(now - start).count();
+    }
+
+  protected:
+    std::chrono::steady_clock::time_point start;
+};
+
+// Calls 'func' for each file with extension 'ext' in the SD card
+// directory 'path' (the SD card root being the bench data directory)
+void benchForEachFile(const char * path, const char * ext,
+                      void (*func)(const char * filename, void * ctx),
+                      void * ctx);
+
+// Loads a model the same way as storage does, including postModelLoad()
+const char * benchLoadModel(const char * path, const char * filename);
+
+// Simulated hardware inputs
+void benchSetAnalog(uint8_t idx, uint16_t value);
+void benchSweepInputs(uint32_t iteration);
+
+// Advance the simulated 10ms timer by 'us' microseconds
+void benchAdvanceTime(uint32_t us);
+
+#endif // _BENCH_H_
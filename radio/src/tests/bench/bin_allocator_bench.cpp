@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <vector>
+
+#include "bench.h"
+#include "bin_allocator.h"
+#include "lua/lua_api.h"
+
+// Reference allocator: linear scan of the bins, as BinAllocator used to do
+template <int SIZE_SLOT, int NUM_BINS> class LinearBinAllocator {
+private:
+  PACK(struct Bin {
+    char data[SIZE_SLOT];
+    bool Used;
+  });
+  struct Bin Bins[NUM_BINS];
+  int NoUsedBins;
+public:
+  LinearBinAllocator() : NoUsedBins(0) {
+    memclear(Bins, sizeof(Bins));
+  }
+  bool free(void * ptr) {
+    for (size_t n = 0; n < NUM_BINS; ++n) {
+      if (ptr == Bins[n].data) {
+        Bins[n].Used = false;
+        --NoUsedBins;
+        return true;
+      }
+    }
+    return false;
+  }
+  bool is_member(void * ptr) {
+    return (ptr >= Bins[0].data && ptr <= Bins[NUM_BINS-1].data);
+  }
+  void * malloc(size_t size) {
+    if (size > SIZE_SLOT || NoUsedBins >= NUM_BINS) return 0;
+    for (size_t n = 0; n < NUM_BINS; ++n) {
+      if (!Bins[n].Used) {
+        Bins[n].Used = true;
+        ++NoUsedBins;
+        return Bins[n].data;
+      }
+    }
+    return 0;
+  }
+  size_t size(void * ptr) {
+    return is_member(ptr) ? SIZE_SLOT : 0;
+  }
+  bool can_fit(void * ptr, size_t size) {
+    return is_member(ptr) && size <= SIZE_SLOT;
+  }
+};
+
+// The same two bin sizes as the firmware
+template <template <int, int> class A>
+struct BinAllocatorPair {
+  A<27, 200> slots1;
+  A<91, 50> slots2;
+
+  bool free(void * ptr)
+  {
+    return slots1.free(ptr) || slots2.free(ptr);
+  }
+
+  void * malloc(size_t size)
+  {
+    void * res = slots1.malloc(size);
+    return res ? res : slots2.malloc(size);
+  }
+
+  // bin_l_alloc(), libc being used when the bins are full
+  void * realloc(void * ptr, size_t nsize)
+  {
+    if (nsize == 0) {
+      if (ptr && !free(ptr)) ::free(ptr);
+      return nullptr;
+    }
+    if (!ptr) {
+      void * res = malloc(nsize);
+      return res ? res : ::malloc(nsize);
+    }
+    if (!slots1.is_member(ptr) && !slots2.is_member(ptr)) {
+      return ::realloc(ptr, nsize);
+    }
+    if (slots1.can_fit(ptr, nsize) || slots2.can_fit(ptr, nsize)) {
+      return ptr;
+    }
+    void * res = malloc(nsize);
+    if (!res) res = ::malloc(nsize);
+    memcpy(res, ptr, slots1.size(ptr) + slots2.size(ptr));
+    free(ptr);
+    return res;
+  }
+};
+
+struct AllocOp {
+  uint32_t id;      // block allocated / resized / freed
+  uint32_t nsize;   // 0 for a free
+};
+
+struct AllocTrace {
+  std::vector<AllocOp> ops;
+  std::vector<void *> blocks;  // recording only: pointer of each block id
+  uint32_t count;
+};
+
+static void * recordAlloc(void * ud, void * ptr, size_t osize, size_t nsize)
+{
+  auto trace = (AllocTrace *)ud;
+  (void)osize;
+
+  uint32_t id = 0;
+  if (ptr) {
+    while (trace->blocks[id] != ptr) id++;
+  }
+  else if (nsize == 0) {
+    return nullptr;
+  }
+  else {
+    id = trace->count++;
+    trace->blocks.push_back(nullptr);
+  }
+
+  void * res = nullptr;
+  if (nsize == 0) {
+    ::free(ptr);
+  }
+  else {
+    res = ::realloc(ptr, nsize);
+  }
+  trace->blocks[id] = res;
+  trace->ops.push_back({ id, (uint32_t)nsize });
+  return res;
+}
+
+// Telemetry widget like workload: strings, small tables and closures
+static const char benchScript[] =
+  "local sensors = {}\n"
+  "for i = 1, 3000 do\n"
+  "  local name = string.format('%s%d', 'RxBt', i % 23)\n"
+  "  local s = sensors[name] or { name = name, hist = {} }\n"
+  "  s.value = i * 0.5\n"
+  "  s.hist[#s.hist % 16 + 1] = { i, s.value }\n"
+  "  s.text = name .. ':' .. tostring(s.value)\n"
+  "  s.fmt = function() return s.text end\n"
+  "  sensors[name] = s\n"
+  "  if i % 500 == 0 then sensors = {} end\n"
+  "end\n";
+
+static void recordLuaTrace(AllocTrace & trace)
+{
+  trace.count = 0;
+  lua_State * L = lua_newstate(recordAlloc, &trace);
+  if (!L) return;
+  luaL_openlibs(L);
+  if (luaL_dostring(L, benchScript)) {
+    TRACE("bin allocator bench: %s", lua_tostring(L, -1));
+  }
+  lua_close(L);
+}
+
+template <class T>
+static double replayTrace(T & allocator, const AllocTrace & trace,
+                          uint32_t iterations)
+{
+  std::vector<void *> blocks(trace.count, nullptr);
+
+  BenchClock clock;
+  for (uint32_t it = 0; it < iterations; it++) {
+    for (const auto & op : trace.ops) {
+      blocks[op.id] = allocator.realloc(blocks[op.id], op.nsize);
+    }
+  }
+  return clock.elapsedNs();
+}
+
+static BinAllocatorPair<LinearBinAllocator> linearBins;
+static BinAllocatorPair<BinAllocator> bins;
+
+// Lua allocation trace replayed on the linear scan and the free list bins
+BENCH(bin_allocator)
+{
+  AllocTrace trace;
+  recordLuaTrace(trace);
+  if (trace.ops.empty()) return;
+
+  uint32_t iterations = options.iterations / 100 + 1;
+  double linearElapsed = replayTrace(linearBins, trace, iterations);
+  double elapsed = replayTrace(bins, trace, iterations);
+
+  uint32_t ops = trace.ops.size() * iterations;
+  report.begin("bin_allocator", "lua_trace");
+  report.add("ops", (uint32_t)trace.ops.size());
+  report.add("iterations", iterations);
+  report.add("ns_per_op_linear", linearElapsed / ops);
+  report.add("ns_per_op", elapsed / ops);
+  report.add("hits_27", bins.slots1.stats().hits);
+  report.add("misses_27", bins.slots1.stats().misses);
+  report.add("max_27", (uint32_t)bins.slots1.stats().highWater);
+  report.add("hits_91", bins.slots2.stats().hits);
+  report.add("misses_91", bins.slots2.stats().misses);
+  report.add("max_91", (uint32_t)bins.slots2.stats().highWater);
+  report.end();
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "bench.h"
+
+static void curvesBenchModel(const char * filename, void * ctx)
+{
+  auto & options = ((BenchContext *)ctx)->options;
+  auto & report = ((BenchContext *)ctx)->report;
+
+  if (benchLoadModel(MODELS_PATH, filename))
+    return;
+
+  // only the models with curves are interesting
+  uint8_t curves[MAX_CURVES];
+  uint8_t count = 0;
+  for (uint8_t i = 0; i < MAX_CURVES; i++) {
+    if (isCurveUsed(i))
+      curves[count++] = i;
+  }
+  if (!count)
+    return;
+
+  int32_t checksum = 0;
+  BenchClock clock;
+  for (uint32_t it = 0; it < options.iterations; it++) {
+    int x = (int)((it * 37) % (2 * RESX + 1)) - RESX;
+    for (uint8_t i = 0; i < count; i++) {
+      checksum += applyCustomCurve(x, curves[i]);
+    }
+  }
+  double elapsed = clock.elapsedNs();
+
+  report.begin("curves", filename);
+  report.add("curves", (uint32_t)count);
+  report.add("iterations", options.iterations);
+  report.add("ns_per_curve", elapsed / options.iterations / count);
+  report.add("checksum", (uint32_t)checksum);
+  report.end();
+}
+
+// applyCustomCurve() on every curve of the models found in /MODELS
+BENCH(curves)
+{
+  BenchContext ctx = { options, report };
+  benchForEachFile(MODELS_PATH, YAML_EXT, curvesBenchModel, &ctx);
+}
@@ -0,0 +1,335 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <unordered_map>
+#include <vector>
+
+#include "bench.h"
+#include "disk_cache.h"
+
+#define BENCH_DISK_SECTORS   (64 * 1024)  // 32MB
+#define BENCH_SECTOR_SIZE    FF_MAX_SS
+
+// RAM disk which counts the accesses: each sector is filled with
+// its own number, unless it has been written
+static uint32_t driverReads;
+static uint32_t driverSectors;
+static uint32_t driverWrites;
+static std::unordered_map<DWORD, std::vector<BYTE>> writtenSectors;
+
+static void fillSectors(BYTE* buff, DWORD sector, UINT count)
+{
+  for (UINT i = 0; i < count; i++) {
+    uint32_t value = sector + i;
+    memcpy(buff + i * BENCH_SECTOR_SIZE, &value, sizeof(value));
+  }
+}
+
+static DSTATUS benchDiskInit(BYTE) { return 0; }
+static DSTATUS benchDiskStatus(BYTE) { return 0; }
+
+static DRESULT benchDiskRead(BYTE, BYTE* buff, DWORD sector, UINT count)
+{
+  driverReads++;
+  driverSectors += count;
+  fillSectors(buff, sector, count);
+  for (UINT i = 0; i < count; i++) {
+    auto it = writtenSectors.find(sector + i);
+    if (it != writtenSectors.end()) {
+      memcpy(buff + i * BENCH_SECTOR_SIZE, it->second.data(), BENCH_SECTOR_SIZE);
+    }
+  }
+  return RES_OK;
+}
+
+static DRESULT benchDiskWrite(BYTE, const BYTE* buff, DWORD sector, UINT count)
+{
+  driverWrites++;
+  for (UINT i = 0; i < count; i++) {
+    const BYTE* data = buff + i * BENCH_SECTOR_SIZE;
+    writtenSectors[sector + i].assign(data, data + BENCH_SECTOR_SIZE);
+  }
+  return RES_OK;
+}
+
+static DRESULT benchDiskIoctl(BYTE, BYTE cmd, void* buff)
+{
+  if (cmd == CTRL_SYNC) return RES_OK;
+  if (cmd != GET_SECTOR_COUNT) return RES_PARERR;
+  *(DWORD*)buff = BENCH_DISK_SECTORS;
+  return RES_OK;
+}
+
+static const diskio_driver_t benchDisk = {
+  .initialize = benchDiskInit,
+  .deinit = nullptr,
+  .status = benchDiskStatus,
+  .read = benchDiskRead,
+  .write = benchDiskWrite,
+  .ioctl = benchDiskIoctl,
+};
+
+// Reference cache: unaligned blocks, linear lookup and
+// round robin eviction, as DiskCache used to do
+class RoundRobinDiskCache
+{
+  struct Block {
+    uint8_t data[DISK_CACHE_BLOCK_SECTORS * BENCH_SECTOR_SIZE];
+    DWORD startSector;
+    DWORD endSector;
+  };
+
+ public:
+  RoundRobinDiskCache() : blocks(new Block[DISK_CACHE_BLOCKS_NUM]) { clear(); }
+  ~RoundRobinDiskCache() { delete[] blocks; }
+
+  void clear()
+  {
+    lastBlock = 0;
+    hits = misses = 0;
+    for (int n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) blocks[n].endSector = 0;
+  }
+
+  DRESULT read(BYTE lun, BYTE* buff, DWORD sector, UINT count)
+  {
+    if (count > DISK_CACHE_BLOCK_SECTORS ||
+        sector + DISK_CACHE_BLOCK_SECTORS >= BENCH_DISK_SECTORS) {
+      return benchDisk.read(lun, buff, sector, count);
+    }
+    for (int n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
+      Block& b = blocks[n];
+      if (sector >= b.startSector && sector + count <= b.endSector) {
+        ++hits;
+        memcpy(buff, b.data + (sector - b.startSector) * BENCH_SECTOR_SIZE,
+               count * BENCH_SECTOR_SIZE);
+        return RES_OK;
+      }
+    }
+    ++misses;
+    Block* b = nullptr;
+    for (int n = 0; n < DISK_CACHE_BLOCKS_NUM && !b; ++n) {
+      if (blocks[n].endSector == 0) b = &blocks[n];
+    }
+    if (!b) {
+      if (++lastBlock >= DISK_CACHE_BLOCKS_NUM) lastBlock = 0;
+      b = &blocks[lastBlock];
+    }
+    DRESULT res = benchDisk.read(lun, b->data, sector, DISK_CACHE_BLOCK_SECTORS);
+    if (res != RES_OK) return res;
+    b->startSector = sector;
+    b->endSector = sector + DISK_CACHE_BLOCK_SECTORS;
+    memcpy(buff, b->data, count * BENCH_SECTOR_SIZE);
+    return RES_OK;
+  }
+
+  void prefetch() {}
+
+  int getHitRate() const
+  {
+    uint32_t all = hits + misses;
+    return all ? (hits * 1000) / all : 0;
+  }
+
+ protected:
+  Block* blocks;
+  uint32_t lastBlock;
+  uint32_t hits;
+  uint32_t misses;
+};
+
+// Audio playback while the UI browses the SD card: a WAV file is
+// read sequentially, 2 sectors at a time, with random reads of the
+// FAT / directory sectors in between. prefetch() is called as often
+// as perMain() would.
+#define METADATA_SECTORS     24
+#define WAV_FIRST_SECTOR     20000
+#define WAV_SECTORS          4000
+#define WAV_READ_SECTORS     2
+
+struct DiskCacheWorkload {
+  uint32_t reads;
+  uint32_t errors;
+};
+
+template <class T>
+static double runWorkload(T& cache, uint32_t iterations,
+                          DiskCacheWorkload& result)
+{
+  static BYTE buffer[WAV_READ_SECTORS * BENCH_SECTOR_SIZE];
+  uint32_t seed = 12345;
+  DWORD wav = WAV_FIRST_SECTOR;
+
+  result.reads = 0;
+  result.errors = 0;
+  driverReads = 0;
+  driverSectors = 0;
+
+  BenchClock clock;
+  for (uint32_t it = 0; it < iterations; it++) {
+    DWORD sector;
+    UINT count;
+    if (it % 3 == 0) {
+      sector = wav;
+      count = WAV_READ_SECTORS;
+      wav += WAV_READ_SECTORS;
+      if (wav >= WAV_FIRST_SECTOR + WAV_SECTORS) wav = WAV_FIRST_SECTOR;
+    } else {
+      seed = seed * 1103515245 + 12345;
+      // FAT and directory entries, scattered over the first sectors
+      sector = 100 + ((seed >> 16) % METADATA_SECTORS) * 37;
+      count = 1;
+    }
+    cache.read(0, buffer, sector, count);
+    result.reads++;
+
+    for (UINT i = 0; i < count; i++) {
+      uint32_t value;
+      memcpy(&value, buffer + i * BENCH_SECTOR_SIZE, sizeof(value));
+      if (value != sector + i) result.errors++;
+    }
+
+    if (it % 8 == 7) {
+      cache.prefetch();
+    }
+  }
+  return clock.elapsedNs();
+}
+
+static RoundRobinDiskCache* roundRobinCache;
+static DiskCache* lruCache;
+
+// DiskCache on a RAM disk, compared to the former round robin cache
+BENCH(disk_cache)
+{
+  if (!roundRobinCache) {
+    roundRobinCache = new RoundRobinDiskCache();
+    lruCache = new DiskCache();
+    lruCache->initialize(&benchDisk);
+  }
+  roundRobinCache->clear();
+  lruCache->clear();
+
+  uint32_t iterations = options.iterations * 10;
+  DiskCacheWorkload rr, lru;
+
+  double rrElapsed = runWorkload(*roundRobinCache, iterations, rr);
+  uint32_t rrDriverReads = driverReads;
+  uint32_t rrDriverSectors = driverSectors;
+
+  double elapsed = runWorkload(*lruCache, iterations, lru);
+
+  const DiskCacheStats& stats = lruCache->getStats();
+  report.begin("disk_cache", "wav_and_metadata");
+  report.add("reads", iterations);
+  report.add("ns_per_read_rr", rrElapsed / iterations);
+  report.add("ns_per_read", elapsed / iterations);
+  report.add("hit_rate_rr", roundRobinCache->getHitRate() / 10.0);
+  report.add("hit_rate", lruCache->getHitRate() / 10.0);
+  report.add("driver_reads_rr", rrDriverReads);
+  report.add("driver_reads", driverReads);
+  report.add("driver_sectors_rr", rrDriverSectors);
+  report.add("driver_sectors", driverSectors);
+  report.add("prefetches", stats.noPrefetches);
+  report.add("prefetch_hits", stats.noPrefetchHits);
+  report.add("errors", rr.errors + lru.errors);
+  report.end();
+}
+
+// Telemetry logging as FatFs does it: the data sectors of the log file
+// are written one by one, f_sync() updating the FAT and the directory
+// entry every 8 sectors. Some sectors are read back to check the data.
+#define LOG_FIRST_SECTOR     30000
+#define LOG_FAT_SECTOR       200
+#define LOG_DIR_SECTOR       300
+#define LOG_SYNC_SECTORS     8
+
+static void writeSector(DWORD sector, uint32_t value)
+{
+  static BYTE buffer[BENCH_SECTOR_SIZE];
+  memcpy(buffer, &value, sizeof(value));
+  lruCache->write(0, buffer, sector, 1);
+}
+
+static bool checkSector(DWORD sector, uint32_t value)
+{
+  static BYTE buffer[BENCH_SECTOR_SIZE];
+  uint32_t read;
+  lruCache->read(0, buffer, sector, 1);
+  memcpy(&read, buffer, sizeof(read));
+  return read == value;
+}
+
+BENCH(disk_cache_write)
+{
+  if (!lruCache) {
+    lruCache = new DiskCache();
+    lruCache->initialize(&benchDisk);
+  }
+  lruCache->clear();
+  writtenSectors.clear();
+  driverWrites = 0;
+
+  uint32_t iterations = options.iterations;
+  uint32_t writes = 0;
+  uint32_t errors = 0;
+
+  BenchClock clock;
+  for (uint32_t it = 0; it < iterations; it++) {
+    DWORD sector = LOG_FIRST_SECTOR + it;
+    writeSector(sector, ~sector);
+    writes++;
+
+    if (it % LOG_SYNC_SECTORS == LOG_SYNC_SECTORS - 1) {
+      writeSector(LOG_FAT_SECTOR, it);
+      writeSector(LOG_DIR_SECTOR, it);
+      writes += 2;
+      lruCache->ioctl(0, CTRL_SYNC, nullptr);
+    }
+
+    if (it % 16 == 5) {
+      // the sector being written, and one written before
+      if (!checkSector(sector, ~sector)) errors++;
+      DWORD previous = LOG_FIRST_SECTOR + (it * 7) % (it + 1);
+      if (!checkSector(previous, ~previous)) errors++;
+    }
+  }
+  lruCache->flush();
+  double elapsed = clock.elapsedNs();
+
+  // everything must have reached the disk
+  for (uint32_t it = 0; it < iterations; it++) {
+    DWORD sector = LOG_FIRST_SECTOR + it;
+    auto found = writtenSectors.find(sector);
+    uint32_t value = 0;
+    if (found != writtenSectors.end()) memcpy(&value, found->second.data(), 4);
+    if (value != ~sector) errors++;
+  }
+
+  const DiskCacheStats& stats = lruCache->getStats();
+  report.begin("disk_cache", "log_writes");
+  report.add("writes", writes);
+  report.add("ns_per_write", elapsed / writes);
+  report.add("driver_writes", driverWrites);
+  report.add("coalesced", stats.noCoalescedWrites);
+  report.add("flushes", stats.noFlushes);
+  report.add("errors", errors);
+  report.end();
+}
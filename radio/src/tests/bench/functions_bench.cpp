@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "bench.h"
+
+void doMixerCalculations();
+
+#define FUNCTIONS_BENCH_MODEL   "heavy_9fm.yml"
+
+static void setFunction(uint8_t idx, swsrc_t swtch, uint8_t func,
+                        int16_t param, int8_t repeat = 0)
+{
+  CustomFunctionData * cfn = &g_model.customFn[idx];
+  memclear(cfn, sizeof(CustomFunctionData));
+  cfn->swtch = swtch;
+  cfn->func = func;
+  CFN_PARAM(cfn) = param;
+  CFN_ACTIVE(cfn) = 1;
+  if (HAS_REPEAT_PARAM(func)) CFN_PLAY_REPEAT(cfn) = repeat;
+}
+
+// A model using all its special functions, most of them triggered by
+// the logical switches, some of them by the switches positions
+static void setBenchFunctions()
+{
+  uint8_t idx = 0;
+  for (uint8_t i = 0; i < 16; i++) {
+    swsrc_t lsw = SWSRC_FIRST_LOGICAL_SWITCH + i;
+    setFunction(idx++, lsw, FUNC_HAPTIC, i % 4, i % 3 == 0 ? 2 : 0);
+    setFunction(idx++, -lsw, FUNC_RESET, FUNC_RESET_TIMER1 + i % 3);
+  }
+  for (uint8_t i = 0; i < 16; i++) {
+    swsrc_t lsw = SWSRC_FIRST_LOGICAL_SWITCH + i;
+    CustomFunctionData * cfn = &g_model.customFn[idx];
+    setFunction(idx++, lsw, FUNC_ADJUST_GVAR, i % 2 ? 10 : -10);
+    CFN_GVAR_INDEX(cfn) = i % MAX_GVARS;
+    CFN_GVAR_MODE(cfn) = i % 2 ? FUNC_ADJUST_GVAR_INCDEC
+                               : FUNC_ADJUST_GVAR_CONSTANT;
+  }
+  for (uint8_t i = 0; idx < MAX_SPECIAL_FUNCTIONS; i++) {
+    swsrc_t sw = SWSRC_FIRST_SWITCH + i % (switchGetMaxSwitches() * 3);
+    CustomFunctionData * cfn = &g_model.customFn[idx];
+    setFunction(idx++, sw, FUNC_OVERRIDE_CHANNEL, -100 + i * 10);
+    CFN_CH_INDEX(cfn) = 8 + i % 8;
+  }
+
+  storageDirty(EE_MODEL);
+}
+
+// The special functions of a model with MAX_SPECIAL_FUNCTIONS defined,
+// evaluated each 10ms
+BENCH(functions)
+{
+  const char * error = benchLoadModel(MODELS_PATH, FUNCTIONS_BENCH_MODEL);
+  report.begin("functions", FUNCTIONS_BENCH_MODEL);
+  if (error) {
+    report.error(error);
+    report.end();
+    return;
+  }
+  setBenchFunctions();
+
+  for (uint32_t i = 0; i < 100; i++) {
+    benchSweepInputs(i);
+    benchAdvanceTime(10000);
+    doMixerCalculations();
+  }
+  debugTimers[debugTimerEvalFunctions].reset();
+
+  double total = 0;
+  uint32_t activations = 0;
+  MASK_CFN_TYPE active = modelFunctionsContext.activeSwitches;
+  for (uint32_t i = 0; i < options.iterations; i++) {
+    benchSweepInputs(i);
+    benchAdvanceTime(10000);
+    doMixerCalculations();
+    total += debugTimers[debugTimerEvalFunctions].getLast();
+    MASK_CFN_TYPE switches = modelFunctionsContext.activeSwitches;
+    activations += __builtin_popcountll(switches & ~active);
+    active = switches;
+  }
+
+  report.add("iterations", options.iterations);
+  report.add("activations", activations);
+  report.add("EvalFunctions_ns", total * 1000 / options.iterations);
+  report.add("EvalFunctions_max_us",
+             (uint32_t)debugTimers[debugTimerEvalFunctions].getMax());
+  report.end();
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "bench.h"
+
+#if defined(LUA)
+
+extern lua_State * lsScripts;
+
+// Sources a telemetry widget reads on every refresh
+static const char * const benchNames[] = {
+  "RSSI", "RxBt", "Curr", "Alt", "Alt+", "VSpd", "ch1", "ch3", "thr", "ls1",
+};
+
+static void luaBenchSensors()
+{
+  memclear(g_model.telemetrySensors, sizeof(g_model.telemetrySensors));
+  // the sensors used by the scripts are usually not the first ones
+  static const char * const labels[] = {
+    "1RSS", "2RSS", "RQly", "RSNR", "ANT", "RFMD", "TPWR", "TRSS", "TQly",
+    "TSNR", "Ptch", "Roll", "Yaw", "FM", "GPS", "GSpd", "Hdg", "Sats",
+    "Capa", "Bat%", "Tmp1", "Tmp2", "Fuel", "RPM", "RSSI", "RxBt", "Curr",
+    "Alt", "VSpd", "A4",
+  };
+  for (unsigned i = 0; i < DIM(labels); i++) {
+    strncpy(g_model.telemetrySensors[i].label, labels[i], TELEM_LABEL_LEN);
+  }
+  storageDirty(EE_MODEL);
+}
+
+// luaFindFieldByName() on its own
+static void luaBenchFindField(const BenchOptions & options, BenchReport & report)
+{
+  uint32_t iterations = options.iterations * 10;
+  uint32_t found = 0;
+  LuaField field;
+
+  BenchClock clock;
+  for (uint32_t it = 0; it < iterations; it++) {
+    found += luaFindFieldByName(benchNames[it % DIM(benchNames)], field);
+  }
+  double elapsed = clock.elapsedNs();
+
+  report.begin("lua", "find_field_by_name");
+  report.add("lookups", iterations);
+  report.add("found", found);
+  report.add("ns_per_lookup", elapsed / iterations);
+  report.end();
+}
+
+// getValue(name) called from a script, as the widgets do
+static void luaBenchGetValue(const BenchOptions & options, BenchReport & report)
+{
+  if (!lsScripts) luaInit();
+  report.begin("lua", "get_value_by_name");
+  if (!lsScripts) {
+    report.error("no Lua state");
+    report.end();
+    return;
+  }
+
+  uint32_t loops = options.iterations;
+  char script[512];
+  int len = snprintf(script, sizeof(script), "for i = 1, %u do\n", loops);
+  for (unsigned i = 0; i < DIM(benchNames); i++) {
+    len += snprintf(script + len, sizeof(script) - len,
+                    "  getValue(\"%s\")\n", benchNames[i]);
+  }
+  snprintf(script + len, sizeof(script) - len, "end\n");
+
+  // the instructions limit hook left by the scripts run before would
+  // yield, which is not possible from luaL_dostring()
+  lua_sethook(lsScripts, nullptr, 0, 0);
+
+  BenchClock clock;
+  if (luaL_dostring(lsScripts, script)) {
+    report.error(lua_tostring(lsScripts, -1));
+    lua_pop(lsScripts, 1);
+    report.end();
+    return;
+  }
+  double elapsed = clock.elapsedNs();
+
+  uint32_t calls = loops * DIM(benchNames);
+  report.add("calls", calls);
+  report.add("calls_per_s", calls * 1e9 / elapsed);
+  report.add("ns_per_call", elapsed / calls);
+  report.end();
+}
+
+// Sources looked up by name with 30 telemetry sensors
+BENCH(lua)
+{
+  luaBenchSensors();
+  luaBenchFindField(options, report);
+  luaBenchGetValue(options, report);
+}
+
+#endif
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "bench.h"
+
+void doMixerCalculations();
+
+// Mixer period of a 250Hz CRSF link
+#define MIXER_BENCH_PERIOD_US   4000
+
+struct MixerStage {
+  const char * name;
+  DebugTimers timer;
+  double total;
+};
+
+static void mixerBenchModel(const char * filename, void * ctx)
+{
+  auto & options = ((BenchContext *)ctx)->options;
+  auto & report = ((BenchContext *)ctx)->report;
+
+  const char * error = benchLoadModel(MODELS_PATH, filename);
+  if (error) {
+    report.begin("mixer", filename);
+    report.error(error);
+    report.end();
+    return;
+  }
+
+  MixerStage stages[] = {
+    { "GetAdc", debugTimerGetAdc, 0 },
+    { "GetSwitches", debugTimerGetSwitches, 0 },
+    { "EvalMixes", debugTimerEvalMixes, 0 },
+    { "EvalLogicalSwitches", debugTimerEvalLogicalSwitches, 0 },
+    { "EvalFunctions", debugTimerEvalFunctions, 0 },
+  };
+
+  // warm-up: first run, model alarms, flight mode init
+  for (uint32_t i = 0; i < 100; i++) {
+    benchSweepInputs(i);
+    benchAdvanceTime(MIXER_BENCH_PERIOD_US);
+    doMixerCalculations();
+  }
+
+  for (auto & stage : stages) {
+    debugTimers[stage.timer].reset();
+  }
+
+  // the outputs checksum tells whether a mixer change alters them
+  uint32_t outputsHash = 0;
+  BenchClock clock;
+  for (uint32_t i = 0; i < options.iterations; i++) {
+    benchSweepInputs(i);
+    benchAdvanceTime(MIXER_BENCH_PERIOD_US);
+    doMixerCalculations();
+    for (auto & stage : stages) {
+      stage.total += debugTimers[stage.timer].getLast();
+    }
+    outputsHash = outputsHash * 31 + hash(channelOutputs, sizeof(channelOutputs));
+  }
+  double elapsed = clock.elapsedNs();
+
+  report.begin("mixer", filename);
+  report.add("iterations", options.iterations);
+  report.add("ns_per_iter", elapsed / options.iterations);
+  for (auto & stage : stages) {
+    char key[32];
+    snprintf(key, sizeof(key), "%s_ns", stage.name);
+    report.add(key, stage.total * 1000 / options.iterations);
+    snprintf(key, sizeof(key), "%s_max_us", stage.name);
+    report.add(key, (uint32_t)debugTimers[stage.timer].getMax());
+  }
+  report.add("outputs_hash", outputsHash);
+  report.end();
+}
+
+// doMixerCalculations() on every model found in /MODELS
+BENCH(mixer)
+{
+  BenchContext ctx = { options, report };
+  benchForEachFile(MODELS_PATH, YAML_EXT, mixerBenchModel, &ctx);
+}
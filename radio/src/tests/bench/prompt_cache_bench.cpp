@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "bench.h"
+#include "prompt_cache.h"
+
+#define BENCH_POOL_SIZE     (512 * 1024)
+#define BENCH_READ_SIZE     (2 * AUDIO_BUFFER_SIZE)  // one audio buffer
+#define BENCH_WAV_HEADER    44
+
+static uint8_t pool[BENCH_POOL_SIZE];
+static uint8_t buffer[BENCH_READ_SIZE];
+
+// Size of the prompts of the english pack at 32kHz: ~0.3s for the
+// numbers, ~0.5s for the units, ~1s for the system sounds
+static uint32_t promptSize(const char * filename)
+{
+  uint32_t hash = 0;
+  for (const char * c = filename; *c; c++) hash = hash * 31 + *c;
+  if (filename[11] == 's') return 48000 + hash % 16000;
+  return (filename[11] == 'u' ? 28000 : 18000) + hash % 6000;
+}
+
+struct PromptWorkload {
+  uint32_t prompts;
+  uint32_t sdOpens;
+  uint32_t sdBytes;
+};
+
+// Plays a prompt as WavContext does, the SD card being simulated
+static void playPrompt(PromptCache * cache, const char * filename,
+                       PromptWorkload & result)
+{
+  uint32_t size = promptSize(filename);
+  result.prompts++;
+
+  if (cache) {
+    PromptCacheHandle handle = cache->find(filename);
+    if (handle.valid()) {
+      for (uint32_t pos = 0; pos < size; pos += BENCH_READ_SIZE) {
+        cache->read(handle, pos, buffer, BENCH_READ_SIZE);
+      }
+      return;
+    }
+  }
+
+  result.sdOpens++;
+  result.sdBytes += BENCH_WAV_HEADER;
+  PromptFormat format = {1, 0, AUDIO_SAMPLE_RATE, size};
+  PromptCacheHandle capture;
+  capture.index = PROMPT_CACHE_NONE;
+  if (cache) capture = cache->create(filename, format);
+  for (uint32_t pos = 0; pos < size; pos += BENCH_READ_SIZE) {
+    uint32_t count = min<uint32_t>(BENCH_READ_SIZE, size - pos);
+    memset(buffer, pos, count);
+    result.sdBytes += count;
+    if (cache && capture.valid()) cache->append(capture, buffer, count);
+  }
+}
+
+// Telemetry announcements: 3 sensors whose values drift (altitude,
+// speed, voltage...) announced in turn, a value (number prompts) being
+// followed by its unit, with some system sounds in between
+static double runPrompts(PromptCache * cache, uint32_t iterations,
+                         PromptWorkload & result)
+{
+  char filename[PROMPT_CACHE_FILENAME_LEN + 1];
+  uint32_t seed = 12345;
+  int32_t sensors[3] = {120, 45, 8};
+  memset(&result, 0, sizeof(result));
+
+  BenchClock clock;
+  for (uint32_t it = 0; it < iterations; it++) {
+    seed = seed * 1103515245 + 12345;
+    int32_t & sensor = sensors[it % 3];
+    sensor = limit<int32_t>(0, sensor + (int32_t)((seed >> 16) % 7) - 3, 249);
+    uint32_t value = sensor;
+    if (value >= 100) {
+      snprintf(filename, sizeof(filename), "/SOUNDS/en/n%04u.wav",
+               value / 100 * 100);
+      playPrompt(cache, filename, result);
+      value %= 100;
+    }
+    if (value > 20) {
+      snprintf(filename, sizeof(filename), "/SOUNDS/en/n%04u.wav",
+               value / 10 * 10);
+      playPrompt(cache, filename, result);
+      value %= 10;
+    }
+    snprintf(filename, sizeof(filename), "/SOUNDS/en/n%04u.wav", value);
+    playPrompt(cache, filename, result);
+
+    snprintf(filename, sizeof(filename), "/SOUNDS/en/u%04u.wav", it % 3);
+    playPrompt(cache, filename, result);
+
+    if (it % 16 == 0) {
+      snprintf(filename, sizeof(filename), "/SOUNDS/en/s%04u.wav",
+               (seed >> 4) % 8);
+      playPrompt(cache, filename, result);
+    }
+  }
+  return clock.elapsedNs();
+}
+
+// Prompts played from the SD card, compared to the prompt cache
+BENCH(prompt_cache)
+{
+  PromptCache * cache = new PromptCache();
+  cache->initialize(pool, sizeof(pool));
+
+  uint32_t iterations = options.iterations / 10 + 1;
+  PromptWorkload sd, cached;
+  runPrompts(nullptr, iterations, sd);
+  double elapsed = runPrompts(cache, iterations, cached);
+
+  const PromptCacheStats & stats = cache->getStats();
+  report.begin("prompt_cache", "telemetry_announces");
+  report.add("prompts", cached.prompts);
+  report.add("sd_opens_no_cache", sd.sdOpens);
+  report.add("sd_opens", cached.sdOpens);
+  report.add("sd_kbytes_no_cache", sd.sdBytes / 1024);
+  report.add("sd_kbytes", cached.sdBytes / 1024);
+  report.add("hit_rate", cache->getHitRate() / 10.0);
+  report.add("evictions", stats.noEvictions);
+  report.add("used_kbytes", stats.usedBytes / 1024);
+  // lookups, copies and insertions, the SD card being simulated
+  report.add("ns_per_prompt", elapsed / cached.prompts);
+  report.end();
+
+  delete cache;
+}
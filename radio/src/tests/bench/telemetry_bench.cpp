@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "bench.h"
+#include "telemetry/frsky_defs.h"
+
+// S.Port sensors, in the order they are usually discovered
+static const uint16_t sportIds[] = {
+  RSSI_ID, ADC2_ID, BATT_ID, R9_PWR_ID,
+  ALT_FIRST_ID, VARIO_FIRST_ID, CURR_FIRST_ID, VFAS_FIRST_ID,
+  CELLS_FIRST_ID, T1_FIRST_ID, T2_FIRST_ID, RPM_FIRST_ID,
+  FUEL_FIRST_ID, ACCX_FIRST_ID, ACCY_FIRST_ID, ACCZ_FIRST_ID,
+  AIR_SPEED_FIRST_ID, A3_FIRST_ID, A4_FIRST_ID, ESC_POWER_FIRST_ID,
+  ESC_RPM_CONS_FIRST_ID, ESC_TEMPERATURE_FIRST_ID, SBEC_POWER_FIRST_ID,
+  GPS_SPEED_FIRST_ID, GPS_ALT_FIRST_ID, GPS_COURS_FIRST_ID,
+};
+
+static uint16_t getBenchSensorId(int index)
+{
+  const int count = DIM(sportIds);
+  // the same ids come back with other instances / physical ids
+  return sportIds[index % count] + index / count;
+}
+
+static void telemetryBenchSensors(const BenchOptions & options,
+                                  BenchReport & report, int sensors)
+{
+  memclear(g_model.telemetrySensors, sizeof(g_model.telemetrySensors));
+  for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+    telemetryItems[i].clear();
+  }
+  storageDirty(EE_MODEL);
+
+  allowNewSensors = true;
+  for (int i = 0; i < sensors; i++) {
+    setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, getBenchSensorId(i), 0,
+                      i & 0x1F, 0, UNIT_RAW, 0);
+  }
+  allowNewSensors = false;
+
+  uint32_t iterations = options.iterations * 10;
+
+  BenchClock clock;
+  for (uint32_t it = 0; it < iterations; it++) {
+    int i = it % sensors;
+    setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, getBenchSensorId(i), 0,
+                      i & 0x1F, it & 0xFF, UNIT_RAW, 0);
+  }
+  double elapsed = clock.elapsedNs();
+
+  char subject[32];
+  snprintf(subject, sizeof(subject), "sport_%d_sensors", sensors);
+  report.begin("telemetry", subject);
+  report.add("iterations", iterations);
+  report.add("ns_per_value", elapsed / iterations);
+  report.end();
+}
+
+// setTelemetryValue() with an increasing number of sensors
+BENCH(telemetry)
+{
+  telemetryBenchSensors(options, report, 10);
+  telemetryBenchSensors(options, report, MAX_TELEMETRY_SENSORS / 2);
+  telemetryBenchSensors(options, report, MAX_TELEMETRY_SENSORS);
+}
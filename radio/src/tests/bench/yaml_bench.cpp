@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "bench.h"
+#include "storage/sdcard_yaml.h"
+#include "storage/yaml/yaml_parser.h"
+#include "storage/yaml/yaml_tree_walker.h"
+#include "storage/yaml/yaml_datastructs.h"
+
+extern const char* readYamlFile(const char* fullpath,
+                                const YamlParserCalls* calls, void* parser_ctx,
+                                ChecksumResult* checksum_result);
+
+// Reference loader: small stack buffer, as readYamlFile() used to do
+static const char* readYamlFileSmallBuffer(const char* fullpath,
+                                           const YamlParserCalls* calls,
+                                           void* parser_ctx,
+                                           uint16_t* checksum)
+{
+  FIL file;
+  UINT bytes_read;
+
+  FRESULT result = f_open(&file, fullpath, FA_OPEN_EXISTING | FA_READ);
+  if (result != FR_OK) {
+    return SDCARD_ERROR(result);
+  }
+
+  YamlParser yp;
+  yp.init(calls, parser_ctx);
+
+  uint16_t crc = 0xFFFF;
+  char buffer[32];
+  while (f_read(&file, buffer, sizeof(buffer) - 1, &bytes_read) == FR_OK) {
+    if (bytes_read == 0) break;
+    crc = crc16(0, (const uint8_t*)buffer, bytes_read, crc);
+    if (f_eof(&file)) yp.set_eof();
+    if (yp.parse(buffer, bytes_read) != YamlParser::CONTINUE_PARSING) break;
+  }
+  f_close(&file);
+
+  *checksum = crc;
+  return nullptr;
+}
+
+static void yamlBenchModel(const char * filename, void * ctx)
+{
+  auto & options = ((BenchContext *)ctx)->options;
+  auto & report = ((BenchContext *)ctx)->report;
+
+  char path[FF_MAX_LFN + 1];
+  snprintf(path, sizeof(path), "%s/%s", MODELS_PATH, filename);
+
+  FILINFO info;
+  if (f_stat(path, &info) != FR_OK) return;
+
+  YamlTreeWalker tree;
+  uint32_t iterations = options.iterations / 10 + 1;
+
+  BenchClock smallClock;
+  for (uint32_t it = 0; it < iterations; it++) {
+    uint16_t checksum;
+    tree.reset(get_modeldata_nodes(), (uint8_t *)&g_model);
+    readYamlFileSmallBuffer(path, YamlTreeWalker::get_parser_calls(), &tree,
+                            &checksum);
+  }
+  double smallElapsed = smallClock.elapsedNs();
+
+  const char * error = nullptr;
+  BenchClock clock;
+  for (uint32_t it = 0; it < iterations && !error; it++) {
+    ChecksumResult checksum;
+    tree.reset(get_modeldata_nodes(), (uint8_t *)&g_model);
+    error = readYamlFile(path, YamlTreeWalker::get_parser_calls(), &tree,
+                         &checksum);
+  }
+  double elapsed = clock.elapsedNs();
+
+  report.begin("yaml", filename);
+  if (error) {
+    report.error(error);
+  } else {
+    report.add("bytes", (uint32_t)info.fsize);
+    report.add("iterations", iterations);
+    report.add("us_per_load_32b", smallElapsed / iterations / 1000);
+    report.add("us_per_load", elapsed / iterations / 1000);
+  }
+  report.end();
+}
+
+// readYamlFile() on the models found in /MODELS,
+// compared to the former 32 bytes buffer loader
+BENCH(yaml)
+{
+  BenchContext ctx = { options, report };
+  benchForEachFile(MODELS_PATH, YAML_EXT, yamlBenchModel, &ctx);
+}
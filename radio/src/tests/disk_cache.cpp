@@ -0,0 +1,359 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "gtests.h"
+#include "disk_cache.h"
+
+#define TEST_DISK_SECTORS  4096
+#define TEST_SECTOR_SIZE   FF_MAX_SS
+
+// RAM disk which counts the accesses, each sector
+// being initially filled with its own number
+static std::vector<uint8_t> diskData;
+static uint32_t diskReads;
+static uint32_t diskWrites;
+static uint32_t diskWrittenSectors;
+static bool diskWriteError;
+
+static DSTATUS testDiskInit(BYTE) { return 0; }
+static DSTATUS testDiskStatus(BYTE) { return 0; }
+
+static DRESULT testDiskRead(BYTE, BYTE* buff, DWORD sector, UINT count)
+{
+  if (sector + count > TEST_DISK_SECTORS) return RES_PARERR;
+  diskReads++;
+  memcpy(buff, &diskData[sector * TEST_SECTOR_SIZE], count * TEST_SECTOR_SIZE);
+  return RES_OK;
+}
+
+static DRESULT testDiskWrite(BYTE, const BYTE* buff, DWORD sector, UINT count)
+{
+  if (sector + count > TEST_DISK_SECTORS || diskWriteError) return RES_ERROR;
+  diskWrites++;
+  diskWrittenSectors += count;
+  memcpy(&diskData[sector * TEST_SECTOR_SIZE], buff, count * TEST_SECTOR_SIZE);
+  return RES_OK;
+}
+
+static DRESULT testDiskIoctl(BYTE, BYTE cmd, void* buff)
+{
+  if (cmd == CTRL_SYNC) return RES_OK;
+  if (cmd != GET_SECTOR_COUNT) return RES_PARERR;
+  *(DWORD*)buff = TEST_DISK_SECTORS;
+  return RES_OK;
+}
+
+static const diskio_driver_t testDisk = {
+  .initialize = testDiskInit,
+  .deinit = nullptr,
+  .status = testDiskStatus,
+  .read = testDiskRead,
+  .write = testDiskWrite,
+  .ioctl = testDiskIoctl,
+};
+
+class DiskCacheTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+      diskData.resize(TEST_DISK_SECTORS * TEST_SECTOR_SIZE);
+      for (uint32_t sector = 0; sector < TEST_DISK_SECTORS; sector++) {
+        fillSector(&diskData[sector * TEST_SECTOR_SIZE], sector);
+      }
+      diskReads = diskWrites = diskWrittenSectors = 0;
+      diskWriteError = false;
+
+      // the blocks are allocated once, the cache being emptied afterwards
+      static bool initialized = false;
+      if (!initialized) {
+        cache.initialize(&testDisk);
+        initialized = true;
+      } else {
+        cache.clear();
+      }
+    }
+
+    static void fillSector(uint8_t* buff, uint32_t value)
+    {
+      for (unsigned i = 0; i < TEST_SECTOR_SIZE; i += sizeof(value)) {
+        memcpy(buff + i, &value, sizeof(value));
+      }
+    }
+
+    // the value the sector is filled with, 0xFFFFFFFF if not uniform
+    static uint32_t sectorValue(const uint8_t* buff)
+    {
+      uint32_t value;
+      memcpy(&value, buff, sizeof(value));
+      for (unsigned i = sizeof(value); i < TEST_SECTOR_SIZE; i += sizeof(value)) {
+        if (memcmp(buff + i, &value, sizeof(value))) return 0xFFFFFFFF;
+      }
+      return value;
+    }
+
+    uint32_t readSector(DWORD sector)
+    {
+      uint8_t buff[TEST_SECTOR_SIZE];
+      EXPECT_EQ(RES_OK, cache.read(0, buff, sector, 1));
+      return sectorValue(buff);
+    }
+
+    DRESULT writeSectors(DWORD sector, UINT count, uint32_t value)
+    {
+      std::vector<uint8_t> buff(count * TEST_SECTOR_SIZE);
+      for (UINT i = 0; i < count; i++) {
+        fillSector(&buff[i * TEST_SECTOR_SIZE], value);
+      }
+      return cache.write(0, buff.data(), sector, count);
+    }
+
+    static uint32_t diskValue(DWORD sector)
+    {
+      return sectorValue(&diskData[sector * TEST_SECTOR_SIZE]);
+    }
+
+    static DiskCache cache;
+};
+
+DiskCache DiskCacheTest::cache;
+
+#if defined(DISK_CACHE_WRITE_BACK)
+TEST_F(DiskCacheTest, ReadAfterBufferedWrite)
+{
+  // cached block: the written data is read from it
+  EXPECT_EQ(5u, readSector(5));
+  EXPECT_EQ(RES_OK, writeSectors(5, 1, 1000));
+  EXPECT_EQ(0u, diskWrites);
+  EXPECT_EQ(1000u, readSector(5));
+  EXPECT_EQ(1u, diskReads);
+  EXPECT_EQ(0u, diskWrites);
+
+  // block not cached: the pending data is flushed before it is read
+  EXPECT_EQ(RES_OK, cache.flush());
+  EXPECT_EQ(RES_OK, writeSectors(40, 2, 2000));
+  EXPECT_EQ(1u, diskWrites);
+  EXPECT_EQ(2000u, readSector(41));
+  EXPECT_EQ(2u, diskWrites);
+  EXPECT_EQ(2000u, diskValue(40));
+  EXPECT_EQ(2000u, diskValue(41));
+  EXPECT_EQ(42u, readSector(42));
+}
+
+TEST_F(DiskCacheTest, WriteOverlappingCachedBlocks)
+{
+  EXPECT_EQ(14u, readSector(14));
+  EXPECT_EQ(17u, readSector(17));
+  EXPECT_EQ(2u, diskReads);
+
+  // across the end of block 0 and the start of block 1
+  EXPECT_EQ(RES_OK, writeSectors(15, 2, 1000));
+  EXPECT_EQ(14u, readSector(14));
+  EXPECT_EQ(1000u, readSector(15));
+  EXPECT_EQ(1000u, readSector(16));
+  EXPECT_EQ(17u, readSector(17));
+  EXPECT_EQ(2u, diskReads);
+  EXPECT_EQ(4u, cache.getStats().noHits);
+
+  EXPECT_EQ(RES_OK, cache.flush());
+  EXPECT_EQ(1u, diskWrites);
+  EXPECT_EQ(1000u, diskValue(15));
+  EXPECT_EQ(1000u, diskValue(16));
+
+  // the cached blocks are still used afterwards
+  EXPECT_EQ(1000u, readSector(16));
+  EXPECT_EQ(2u, diskReads);
+}
+
+TEST_F(DiskCacheTest, CoalescedWrites)
+{
+  EXPECT_EQ(RES_OK, writeSectors(10, 1, 1000));
+  EXPECT_EQ(RES_OK, writeSectors(11, 2, 1001));
+  EXPECT_EQ(RES_OK, writeSectors(13, 1, 1002));
+  EXPECT_EQ(RES_OK, writeSectors(11, 1, 1003));
+  EXPECT_EQ(0u, diskWrites);
+  EXPECT_EQ(3u, cache.getStats().noCoalescedWrites);
+
+  // a sync writes them at once
+  EXPECT_EQ(RES_OK, cache.ioctl(0, CTRL_SYNC, nullptr));
+  EXPECT_EQ(1u, diskWrites);
+  EXPECT_EQ(4u, diskWrittenSectors);
+  EXPECT_EQ(1u, cache.getStats().noFlushes);
+  EXPECT_EQ(1000u, diskValue(10));
+  EXPECT_EQ(1003u, diskValue(11));
+  EXPECT_EQ(1001u, diskValue(12));
+  EXPECT_EQ(1002u, diskValue(13));
+
+  // neither a gap, nor more than DISK_CACHE_WRITE_SECTORS are coalesced
+  EXPECT_EQ(RES_OK, writeSectors(100, 1, 2000));
+  EXPECT_EQ(RES_OK, writeSectors(102, 1, 2001));
+  EXPECT_EQ(2u, diskWrites);
+  EXPECT_EQ(RES_OK,
+            writeSectors(103, DISK_CACHE_WRITE_SECTORS - 1, 2002));
+  EXPECT_EQ(2u, diskWrites);
+  EXPECT_EQ(RES_OK, writeSectors(102 + DISK_CACHE_WRITE_SECTORS, 1, 2003));
+  EXPECT_EQ(3u, diskWrites);
+  EXPECT_EQ(2001u, diskValue(102));
+  EXPECT_EQ(2002u, diskValue(101 + DISK_CACHE_WRITE_SECTORS));
+  EXPECT_EQ(4u, cache.getStats().noCoalescedWrites);
+}
+
+TEST_F(DiskCacheTest, FlushExpired)
+{
+  // as done by storagePeriodicTasks()
+  EXPECT_EQ(RES_OK, writeSectors(10, 1, 1000));
+  cache.flushExpired();
+  EXPECT_EQ(0u, diskWrites);
+
+  std::this_thread::sleep_for(
+      std::chrono::milliseconds(DISK_CACHE_WRITE_DELAY + 10));
+  cache.flushExpired();
+  EXPECT_EQ(1u, diskWrites);
+  EXPECT_EQ(1000u, diskValue(10));
+
+  // nothing left pending
+  cache.flushExpired();
+  EXPECT_EQ(RES_OK, cache.flush());
+  EXPECT_EQ(1u, diskWrites);
+  EXPECT_EQ(1u, cache.getStats().noFlushes);
+}
+
+TEST_F(DiskCacheTest, FailedWriteInvalidatesBlocks)
+{
+  EXPECT_EQ(5u, readSector(5));
+  EXPECT_EQ(20u, readSector(20));
+  EXPECT_EQ(2u, diskReads);
+
+  // written directly, being bigger than the write buffer
+  diskWriteError = true;
+  EXPECT_NE(RES_OK, writeSectors(0, DISK_CACHE_WRITE_SECTORS * 2, 1000));
+  diskWriteError = false;
+  EXPECT_EQ(5u, readSector(5));
+  EXPECT_EQ(20u, readSector(20));
+  EXPECT_EQ(4u, diskReads);
+
+  // the pending data cannot be flushed to make room for the new one
+  EXPECT_EQ(RES_OK, writeSectors(2, 1, 2000));
+  diskWriteError = true;
+  EXPECT_NE(RES_OK, writeSectors(20, 1, 2001));
+  diskWriteError = false;
+  EXPECT_EQ(20u, readSector(20));
+  EXPECT_EQ(5u, diskReads);
+
+  // it has been kept, to be written again
+  EXPECT_EQ(RES_OK, cache.flush());
+  EXPECT_EQ(2000u, diskValue(2));
+  EXPECT_EQ(20u, diskValue(20));
+}
+#endif
+
+// the first sector of each block is read: no sequential stream
+TEST_F(DiskCacheTest, LeastRecentlyUsedEvicted)
+{
+  for (uint32_t block = 0; block < DISK_CACHE_BLOCKS_NUM; block++) {
+    EXPECT_EQ(block * DISK_CACHE_BLOCK_SECTORS,
+              readSector(block * DISK_CACHE_BLOCK_SECTORS));
+  }
+  EXPECT_EQ((uint32_t)DISK_CACHE_BLOCKS_NUM, diskReads);
+
+  // block 0 is used again, block 1 becomes the least recently used
+  EXPECT_EQ(0u, readSector(0));
+  const DWORD sector = DISK_CACHE_BLOCKS_NUM * DISK_CACHE_BLOCK_SECTORS;
+  EXPECT_EQ(sector, readSector(sector));
+  EXPECT_EQ((uint32_t)DISK_CACHE_BLOCKS_NUM + 1, diskReads);
+
+  EXPECT_EQ(0u, readSector(0));
+  EXPECT_EQ((uint32_t)DISK_CACHE_BLOCKS_NUM + 1, diskReads);
+  EXPECT_EQ(16u, readSector(16));
+  EXPECT_EQ((uint32_t)DISK_CACHE_BLOCKS_NUM + 2, diskReads);
+
+  // block 2 has been evicted to read block 1 again, not block 3
+  EXPECT_EQ(48u, readSector(48));
+  EXPECT_EQ((uint32_t)DISK_CACHE_BLOCKS_NUM + 2, diskReads);
+  EXPECT_EQ(32u, readSector(32));
+  EXPECT_EQ((uint32_t)DISK_CACHE_BLOCKS_NUM + 3, diskReads);
+}
+
+TEST_F(DiskCacheTest, SequentialReadEvictsItsBlocks)
+{
+  for (uint32_t block = 0; block < DISK_CACHE_BLOCKS_NUM; block++) {
+    readSector(block * DISK_CACHE_BLOCK_SECTORS);
+  }
+
+  // a file streamed over 8 blocks
+  uint8_t buff[DISK_CACHE_BLOCK_SECTORS * TEST_SECTOR_SIZE];
+  for (uint32_t block = 64; block < 72; block++) {
+    EXPECT_EQ(RES_OK, cache.read(0, buff, block * DISK_CACHE_BLOCK_SECTORS,
+                                 DISK_CACHE_BLOCK_SECTORS));
+    EXPECT_EQ(block * DISK_CACHE_BLOCK_SECTORS, sectorValue(buff));
+  }
+  EXPECT_EQ((uint32_t)DISK_CACHE_BLOCKS_NUM + 8, diskReads);
+
+  // once detected, the stream only replaces its own blocks
+  for (uint32_t block = 3; block < DISK_CACHE_BLOCKS_NUM; block++) {
+    readSector(block * DISK_CACHE_BLOCK_SECTORS);
+  }
+  EXPECT_EQ((uint32_t)DISK_CACHE_BLOCKS_NUM + 8, diskReads);
+  EXPECT_EQ(71u * DISK_CACHE_BLOCK_SECTORS,
+            readSector(71 * DISK_CACHE_BLOCK_SECTORS));
+  EXPECT_EQ((uint32_t)DISK_CACHE_BLOCKS_NUM + 8, diskReads);
+}
+
+TEST_F(DiskCacheTest, HashBucketCollisions)
+{
+  // blocks in the same hash bucket
+  const DWORD sectors[] = {
+    0,
+    DISK_CACHE_HASH_SIZE * DISK_CACHE_BLOCK_SECTORS,
+    2 * DISK_CACHE_HASH_SIZE * DISK_CACHE_BLOCK_SECTORS,
+  };
+
+  for (auto sector : sectors) {
+    EXPECT_EQ(sector + 1, readSector(sector + 1));
+  }
+  for (auto sector : sectors) {
+    EXPECT_EQ(sector + 2, readSector(sector + 2));
+  }
+  EXPECT_EQ(3u, diskReads);
+  EXPECT_EQ(3u, cache.getStats().noHits);
+
+  // the block in the middle of the bucket is removed
+  diskWriteError = true;
+  EXPECT_NE(RES_OK, writeSectors(sectors[1], DISK_CACHE_BLOCK_SECTORS * 2,
+                                 1000));
+  diskWriteError = false;
+
+  EXPECT_EQ(sectors[0] + 3, readSector(sectors[0] + 3));
+  EXPECT_EQ(sectors[2] + 3, readSector(sectors[2] + 3));
+  EXPECT_EQ(3u, diskReads);
+  EXPECT_EQ(sectors[1] + 3, readSector(sectors[1] + 3));
+  EXPECT_EQ(4u, diskReads);
+
+  // and the bucket is complete again
+  for (auto sector : sectors) {
+    EXPECT_EQ(sector + 4, readSector(sector + 4));
+  }
+  EXPECT_EQ(4u, diskReads);
+}
@@ -530,3 +530,35 @@ TEST(FrSkySPORT, frskyCurrent)
   EXPECT_EQ(telemetryItems[0].valueMax, 505);
 }
 
+
+TEST(FrSkySPORT, sensorsSharingSameId)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  allowNewSensors = true;
+
+  setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, T1_FIRST_ID, 0, 0, 25, UNIT_CELSIUS, 0);
+  EXPECT_EQ(telemetryItems[0].value, 25);
+
+  // a copy of the first sensor receives the same values
+  g_model.telemetrySensors[1] = g_model.telemetrySensors[0];
+  storageDirty(EE_MODEL);
+  setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, T1_FIRST_ID, 0, 0, 30, UNIT_CELSIUS, 0);
+  EXPECT_EQ(telemetryItems[0].value, 30);
+  EXPECT_EQ(telemetryItems[1].value, 30);
+
+  // once its id is changed, it receives its own values
+  g_model.telemetrySensors[1].id = T1_FIRST_ID + 1;
+  storageDirty(EE_MODEL);
+  setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, T1_FIRST_ID + 1, 0, 0, 40, UNIT_CELSIUS, 0);
+  EXPECT_EQ(telemetryItems[0].value, 30);
+  EXPECT_EQ(telemetryItems[1].value, 40);
+  EXPECT_FALSE(g_model.telemetrySensors[2].isAvailable());
+
+  // deleted sensors do not receive values anymore
+  delTelemetryIndex(0);
+  allowNewSensors = false;
+  setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, T1_FIRST_ID, 0, 0, 50, UNIT_CELSIUS, 0);
+  EXPECT_FALSE(telemetryItems[0].isAvailable());
+  EXPECT_EQ(telemetryItems[1].value, 40);
+}
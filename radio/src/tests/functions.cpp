@@ -121,6 +121,68 @@ TEST_F(SpecialFunctionsTest, GvarsInc)
   evalFunctions(g_model.customFn, modelFunctionsContext);
   EXPECT_EQ(g_model.flightModeData[0].gvars[0], 28);
 }
+
+TEST_F(SpecialFunctionsTest, LogicalSwitchTrigger)
+{
+  MIXER_RESET();
+  simuSetSwitch(0, 0);    // SA-
+
+  // L1 = SAdown
+  g_model.logicalSw[0].func = LS_FUNC_AND;
+  g_model.logicalSw[0].v1 = SWSRC_FIRST_SWITCH;
+  g_model.logicalSw[0].v2 = SWSRC_NONE;
+
+  // GV1 incremented when L1 is activated
+  g_model.customFn[0].swtch = SWSRC_FIRST_LOGICAL_SWITCH;
+  g_model.customFn[0].func = FUNC_ADJUST_GVAR;
+  g_model.customFn[0].all.mode = FUNC_ADJUST_GVAR_INCDEC;
+  g_model.customFn[0].all.param = 0; // GV1
+  g_model.customFn[0].all.val = 1;
+  g_model.customFn[0].active = true;
+
+  // GV2 = 5 while L1 is not active
+  g_model.customFn[1].swtch = -SWSRC_FIRST_LOGICAL_SWITCH;
+  g_model.customFn[1].func = FUNC_ADJUST_GVAR;
+  g_model.customFn[1].all.mode = FUNC_ADJUST_GVAR_CONSTANT;
+  g_model.customFn[1].all.param = 1; // GV2
+  g_model.customFn[1].all.val = 5;
+  g_model.customFn[1].active = true;
+
+  evalLogicalSwitches();
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(g_model.flightModeData[0].gvars[0], 0);
+  EXPECT_EQ(g_model.flightModeData[0].gvars[1], 5);
+
+  // applied on each tick, even when L1 doesn't change
+  g_model.flightModeData[0].gvars[1] = 0;
+  evalLogicalSwitches();
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(g_model.flightModeData[0].gvars[1], 5);
+
+  simuSetSwitch(0, -1);  // SAdown
+  evalLogicalSwitches();
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(g_model.flightModeData[0].gvars[0], 1);
+
+  g_model.flightModeData[0].gvars[1] = 0;
+  for (int i = 0; i < 3; i++) {
+    evalLogicalSwitches();
+    evalFunctions(g_model.customFn, modelFunctionsContext);
+  }
+  EXPECT_EQ(g_model.flightModeData[0].gvars[0], 1);
+  EXPECT_EQ(g_model.flightModeData[0].gvars[1], 0);
+
+  simuSetSwitch(0, 0);    // SA-
+  evalLogicalSwitches();
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(g_model.flightModeData[0].gvars[0], 1);
+  EXPECT_EQ(g_model.flightModeData[0].gvars[1], 5);
+
+  simuSetSwitch(0, -1);  // SAdown
+  evalLogicalSwitches();
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(g_model.flightModeData[0].gvars[0], 2);
+}
 #endif // #if defined(GVARS)
 
 #endif // #if defined(PCBFRSKY)
@@ -74,6 +74,9 @@ inline void MODEL_RESET()
   s_mixer_first_run_done = false;
   evalMixes(1);  // this is needed to reset fp_act
   lastFlightMode = 255;
+  invalidateMixerProgram();
+  invalidateLogicalSwitchesOrder();
+  invalidateFunctionsDispatch();
 }
 
 inline void MIXER_RESET()
@@ -86,6 +89,7 @@ inline void MIXER_RESET()
   mixerCurrentFlightMode = lastFlightMode = 0;
   lastAct = 0;
   logicalSwitchesReset();
+  invalidateMixerProgram();
 }
 
 inline void TELEMETRY_RESET()
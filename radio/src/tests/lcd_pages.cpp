@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+
+#if !defined(COLORLCD)
+TEST(Lcd, ChangedPages)
+{
+  lcdClear();
+  lcdInvalidatePages();
+  EXPECT_EQ(lcdGetChangedPages(), 0xFF);
+  EXPECT_EQ(lcdGetChangedPages(), 0);
+
+  // the screen drawn again with the same content
+  lcdClear();
+  lcdDrawText(0, 2 * FH, "Test");
+  EXPECT_EQ(lcdGetChangedPages(), 1 << 2);
+  lcdClear();
+  lcdDrawText(0, 2 * FH, "Test");
+  EXPECT_EQ(lcdGetChangedPages(), 0);
+
+  lcdDrawSolidVerticalLine(LCD_W - 1, 0, 2 * FH);
+  EXPECT_EQ(lcdGetChangedPages(), (1 << 0) | (1 << 1));
+}
+#endif
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+#include "location.h"
+
+#if defined(SDCARD)
+
+#define LOGS_TEST_MODEL  "logstest"
+
+class LogsTest : public OpenTxTest
+{
+  protected:
+    void SetUp() override
+    {
+      OpenTxTest::SetUp();
+      simuFatfsSetPaths(TESTS_BUILD_PATH "/", TESTS_BUILD_PATH "/");
+      removeLogs();
+
+      strncpy(g_model.header.name, LOGS_TEST_MODEL, LEN_MODEL_NAME);
+      CustomFunctionData * cfn = &g_model.customFn[0];
+      cfn->swtch = SWSRC_ON;
+      cfn->func = FUNC_LOGS;
+      CFN_PARAM(cfn) = 1;  // 100ms
+      CFN_ACTIVE(cfn) = 1;
+      evalFunctions(g_model.customFn, modelFunctionsContext);
+    }
+
+    void TearDown() override
+    {
+      modelFunctionsContext.reset();
+      logsClose();
+      removeLogs();
+      simuFatfsSetPaths("", "");
+    }
+
+    // the log files of the test model
+    template <class F>
+    void forEachLog(F func)
+    {
+      DIR dir;
+      FILINFO fno;
+      if (f_opendir(&dir, LOGS_PATH) != FR_OK) return;
+      while (f_readdir(&dir, &fno) == FR_OK && fno.fname[0]) {
+        if (!strncmp(fno.fname, LOGS_TEST_MODEL, strlen(LOGS_TEST_MODEL))) {
+          char path[sizeof(LOGS_PATH) + FF_MAX_LFN + 1];
+          snprintf(path, sizeof(path), LOGS_PATH "/%s", fno.fname);
+          func(path);
+        }
+      }
+      f_closedir(&dir);
+    }
+
+    void removeLogs()
+    {
+      forEachLog([](const char * path) { f_unlink(path); });
+    }
+
+    // the lines of the log file, which must be the only one
+    std::vector<std::string> readLogs()
+    {
+      std::vector<std::string> lines;
+      int files = 0;
+      forEachLog([&](const char * path) {
+        FIL file;
+        char line[1024];
+        files++;
+        if (f_open(&file, path, FA_READ) != FR_OK) return;
+        while (f_gets(line, sizeof(line), &file)) {
+          lines.push_back(line);
+        }
+        f_close(&file);
+      });
+      EXPECT_EQ(1, files);
+      return lines;
+    }
+
+    void writeLines(int count)
+    {
+      for (int i = 0; i < count; i++) {
+        g_tmr10ms += 10;
+        logsWrite();
+      }
+    }
+};
+
+#if defined(RTCLOCK)
+  #define LOGS_HEADER_START  "Date,Time,"
+#else
+  #define LOGS_HEADER_START  "Time,"
+#endif
+
+TEST_F(LogsTest, HeaderBeforeBufferedLines)
+{
+  writeLines(3);
+  logsFlush();
+  writeLines(2);
+  logsClose();
+
+  auto lines = readLogs();
+  ASSERT_EQ(6u, lines.size());
+  EXPECT_EQ(0u, lines[0].find(LOGS_HEADER_START));
+  for (unsigned i = 1; i < lines.size(); i++) {
+    EXPECT_NE(0u, lines[i].find(LOGS_HEADER_START));
+    EXPECT_EQ('\n', lines[i].back());
+  }
+}
+
+TEST_F(LogsTest, CloseDropsUnwrittenLines)
+{
+  // closed before any flush: no file, the lines are dropped
+  writeLines(3);
+  logsClose();
+
+  writeLines(1);
+  logsFlush();
+  logsClose();
+
+  auto lines = readLogs();
+  ASSERT_EQ(2u, lines.size());
+  EXPECT_EQ(0u, lines[0].find(LOGS_HEADER_START));
+}
+
+TEST_F(LogsTest, FullBufferDropsLines)
+{
+  // much more lines than the buffer holds, before the file is opened
+  writeLines(100);
+  logsFlush();
+  logsClose();
+
+  auto lines = readLogs();
+  ASSERT_GT(lines.size(), 2u);
+  ASSERT_LT(lines.size(), 100u);
+  EXPECT_EQ(0u, lines[0].find(LOGS_HEADER_START));
+  for (unsigned i = 1; i < lines.size(); i++) {
+    EXPECT_EQ('\n', lines[i].back());
+  }
+}
+
+#endif
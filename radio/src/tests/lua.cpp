@@ -21,11 +21,13 @@
 
 #include <math.h>
 #include "gtests.h"
+#include "location.h"
 
 #if defined(LUA)
 
 #define SWAP_DEFINED
 #include "opentx.h"
+#include "lua/lua_cache.h"
 
 #define MIXSRC_THR     (MIXSRC_FIRST_STICK + inputMappingGetThrottle())
 #define MIXSRC_TRIMTHR (MIXSRC_FIRST_TRIM + inputMappingGetThrottle())
@@ -188,4 +190,147 @@ TEST(Lua, Switches)
   luaExecStr("if MIXSRC_SB == nil then error('failed') end");
 }
 
+static void setSensorLabel(int index, const char * label)
+{
+  strncpy(g_model.telemetrySensors[index].label, label, TELEM_LABEL_LEN);
+  storageDirty(EE_MODEL);
+}
+
+TEST(Lua, FieldsByName)
+{
+  MODEL_RESET();
+  LuaField field;
+
+  EXPECT_TRUE(luaFindFieldByName("tx-voltage", field));
+  EXPECT_EQ(field.id, MIXSRC_TX_VOLTAGE);
+  EXPECT_TRUE(luaFindFieldByName("clock", field));
+  EXPECT_EQ(field.id, MIXSRC_TX_TIME);
+  EXPECT_TRUE(luaFindFieldByName("ch16", field));
+  EXPECT_EQ(field.id, MIXSRC_FIRST_CH + 15);
+  EXPECT_FALSE(luaFindFieldByName("RSSI", field));
+
+  setSensorLabel(2, "RSSI");
+  setSensorLabel(5, "RxBt");
+  setSensorLabel(7, "RSSI");
+  EXPECT_TRUE(luaFindFieldByName("RSSI", field));
+  EXPECT_EQ(field.id, MIXSRC_FIRST_TELEM + 3 * 2);
+  EXPECT_TRUE(luaFindFieldByName("RxBt-", field));
+  EXPECT_EQ(field.id, MIXSRC_FIRST_TELEM + 3 * 5 + 1);
+  EXPECT_TRUE(luaFindFieldByName("RxBt+", field));
+  EXPECT_EQ(field.id, MIXSRC_FIRST_TELEM + 3 * 5 + 2);
+  EXPECT_FALSE(luaFindFieldByName("RxB", field));
+  EXPECT_FALSE(luaFindFieldByName("RxBt*", field));
+
+  // the index follows the sensors changes
+  delTelemetryIndex(2);
+  EXPECT_TRUE(luaFindFieldByName("RSSI", field));
+  EXPECT_EQ(field.id, MIXSRC_FIRST_TELEM + 3 * 7);
+  setSensorLabel(1, "RSSI");
+  EXPECT_TRUE(luaFindFieldByName("RSSI", field));
+  EXPECT_EQ(field.id, MIXSRC_FIRST_TELEM + 3 * 1);
+  setSensorLabel(5, "Bat");
+  EXPECT_FALSE(luaFindFieldByName("RxBt", field));
+  EXPECT_TRUE(luaFindFieldByName("Bat", field));
+  EXPECT_EQ(field.id, MIXSRC_FIRST_TELEM + 3 * 5);
+}
+
+#if defined(LUA_COMPILER)
+static void writeScript(const char * filename, const char * source)
+{
+  FIL file;
+  UINT written;
+  ASSERT_EQ(FR_OK, f_open(&file, filename, FA_CREATE_ALWAYS | FA_WRITE));
+  f_write(&file, source, strlen(source), &written);
+  f_close(&file);
+}
+
+#define CACHE_TEST_SCRIPT  SCRIPTS_PATH "/cachetst.lua"
+
+TEST(Lua, BytecodeCache)
+{
+  extern lua_State * lsScripts;
+  simuFatfsSetPaths(TESTS_BUILD_PATH "/", TESTS_BUILD_PATH "/");
+  sdCheckAndCreateDirectory(SCRIPTS_PATH);
+  f_unlink(LUA_CACHE_FILE);
+  f_unlink(SCRIPTS_PATH "/cachetst.luac");
+  writeScript(CACHE_TEST_SCRIPT, "return 6 * 7");
+
+  luaInit();
+  ASSERT_NE(nullptr, lsScripts);
+  LuaCacheStats before = luaCache.getStats();
+
+  // compiled, then loaded from the cache
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(SCRIPT_OK, luaLoadScriptFileToState(lsScripts, CACHE_TEST_SCRIPT, "bt"));
+    lua_call(lsScripts, 0, 1);
+    EXPECT_EQ(42, lua_tointeger(lsScripts, -1));
+    lua_pop(lsScripts, 1);
+  }
+  EXPECT_EQ(before.noInsertions + 1, luaCache.getStats().noInsertions);
+  EXPECT_EQ(before.noHits + 2, luaCache.getStats().noHits);
+  EXPECT_NE(FR_OK, f_stat(SCRIPTS_PATH "/cachetst.luac", nullptr));
+
+  // the index is read again from the file
+  luaInit();
+  EXPECT_EQ(SCRIPT_OK, luaLoadScriptFileToState(lsScripts, CACHE_TEST_SCRIPT, "bt"));
+  lua_call(lsScripts, 0, 1);
+  EXPECT_EQ(42, lua_tointeger(lsScripts, -1));
+  lua_pop(lsScripts, 1);
+  EXPECT_EQ(before.noHits + 3, luaCache.getStats().noHits);
+
+  // the source changed: compiled again
+  writeScript(CACHE_TEST_SCRIPT, "return 6 * 7 + 1");
+  EXPECT_EQ(SCRIPT_OK, luaLoadScriptFileToState(lsScripts, CACHE_TEST_SCRIPT, "bt"));
+  lua_call(lsScripts, 0, 1);
+  EXPECT_EQ(43, lua_tointeger(lsScripts, -1));
+  lua_pop(lsScripts, 1);
+  EXPECT_EQ(before.noInsertions + 2, luaCache.getStats().noInsertions);
+
+  // a record whose size wraps around is dropped
+  {
+    FIL file;
+    ASSERT_EQ(FR_OK, f_open(&file, LUA_CACHE_FILE, FA_OPEN_APPEND | FA_WRITE));
+    // on the radio, 20 + 255 + length bytes wraps to 0 in 32 bits
+    uint8_t record[20] = {0};
+    const uint32_t length = 0u - 20 - 255;
+    memcpy(record + 12, &length, sizeof(length));
+    record[16] = 255;  // pathLen
+    UINT written;
+    f_write(&file, record, sizeof(record), &written);
+    f_close(&file);
+  }
+  luaInit();
+  EXPECT_EQ(SCRIPT_OK, luaLoadScriptFileToState(lsScripts, CACHE_TEST_SCRIPT, "bt"));
+  lua_call(lsScripts, 0, 1);
+  EXPECT_EQ(43, lua_tointeger(lsScripts, -1));
+  lua_pop(lsScripts, 1);
+  EXPECT_EQ(before.noInsertions + 3, luaCache.getStats().noInsertions);
+
+  // per script load figures
+  const LuaCacheStats& stats = luaCache.getStats();
+  const LuaScriptLoadStats* script = nullptr;
+  for (uint8_t i = 0; i < stats.scriptsCount; i++) {
+    if (!strcmp(stats.scripts[i].name, "cachetst.lua"))
+      script = &stats.scripts[i];
+  }
+  ASSERT_NE(nullptr, script);
+  EXPECT_EQ(6, script->noLoads);
+  EXPECT_FALSE(script->cached);
+  EXPECT_GE(script->maxDuration, script->lastDuration);
+
+  // a cache file from another firmware is dropped
+  writeScript(LUA_CACHE_FILE, "ELC1 garbage");
+  luaInit();
+  EXPECT_EQ(SCRIPT_OK, luaLoadScriptFileToState(lsScripts, CACHE_TEST_SCRIPT, "bt"));
+  lua_call(lsScripts, 0, 1);
+  EXPECT_EQ(43, lua_tointeger(lsScripts, -1));
+  lua_pop(lsScripts, 1);
+  EXPECT_EQ(before.noInsertions + 4, luaCache.getStats().noInsertions);
+
+  f_unlink(LUA_CACHE_FILE);
+  f_unlink(CACHE_TEST_SCRIPT);
+  simuFatfsSetPaths("", "");
+}
+#endif
+
 #endif   // #if defined(LUA)
@@ -610,6 +610,34 @@ TEST(Curves, LinearIntpol)
   EXPECT_EQ(applyCustomCurve(-192, 0), -192);
 }
 
+TEST(Curves, SmoothCurveUpdate)
+{
+  SYSTEM_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+  setModelDefaults();
+  g_model.curves[0].smooth = 1;
+  loadCurves();
+  for (int8_t i=-2; i<=2; i++) {
+    g_model.points[2+i] = 50*i;
+  }
+  storageDirty(EE_MODEL);
+  EXPECT_EQ(applyCustomCurve(-1024, 0), -1024);
+  EXPECT_EQ(applyCustomCurve(-512, 0), -512);
+  EXPECT_EQ(applyCustomCurve(0, 0), 0);
+  EXPECT_EQ(applyCustomCurve(1024, 0), 1024);
+  EXPECT_LE(abs(applyCustomCurve(-192, 0) + 192), 1);
+
+  // tangents must follow the points
+  for (int8_t i=-2; i<=2; i++) {
+    g_model.points[2+i] = -50*i;
+  }
+  storageDirty(EE_MODEL);
+  EXPECT_EQ(applyCustomCurve(-1024, 0), 1024);
+  EXPECT_EQ(applyCustomCurve(0, 0), 0);
+  EXPECT_LE(abs(applyCustomCurve(-192, 0) - 192), 1);
+}
+
 
 
 TEST_F(MixerTest, InfiniteRecursiveChannels)
@@ -658,6 +686,30 @@ TEST_F(MixerTest, RecursiveAddChannel)
   EXPECT_EQ(chans[1], 0);
 }
 
+TEST_F(MixerTest, CascadedChannels)
+{
+  // CH1 <- CH2 <- ... <- CH8 <- MAX: each channel uses the next one
+  for (uint8_t i = 0; i < 8; i++) {
+    g_model.mixData[i].destCh = i;
+    g_model.mixData[i].srcRaw = (i < 7) ? MIXSRC_FIRST_CH + i + 1 : MIXSRC_MAX;
+    g_model.mixData[i].weight = 100;
+  }
+  // CH9 <- CH1, CH8
+  g_model.mixData[8].destCh = 8;
+  g_model.mixData[8].srcRaw = MIXSRC_FIRST_CH;
+  g_model.mixData[8].weight = 50;
+  g_model.mixData[9].destCh = 8;
+  g_model.mixData[9].srcRaw = MIXSRC_FIRST_CH + 7;
+  g_model.mixData[9].weight = -100;
+
+  // all channels are up to date after a single evaluation
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  for (uint8_t i = 0; i < 8; i++) {
+    EXPECT_EQ(chans[i], CHANNEL_MAX);
+  }
+  EXPECT_EQ(chans[8], -CHANNEL_MAX/2);
+}
+
 TEST_F(MixerTest, RecursiveAddChannelAfterInactivePhase)
 {
   g_model.flightModeData[1].swtch = SWSRC_FIRST_SWITCH + 1;
@@ -1037,6 +1089,52 @@ TEST_F(MixerTest, flightModeTransition)
   CHECK_FLIGHT_MODE_TRANSITION(0, 1000, 1024, -102);
 }
 
+#if defined(GVARS)
+TEST_F(MixerTest, flightModeTransitionGVars)
+{
+  SYSTEM_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+  setModelDefaults();
+  g_model.flightModeData[1].swtch = SWSRC_FIRST_SWITCH + 2;
+  g_model.flightModeData[0].fadeIn = 100;
+  g_model.flightModeData[0].fadeOut = 100;
+  g_model.flightModeData[0].gvars[0] = 100;
+  g_model.flightModeData[1].gvars[0] = -50;
+  // CH1 weight is GV1
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].srcRaw = MIXSRC_MAX;
+  g_model.mixData[0].weight = GV1_LARGE;
+  // CH2 does not depend on the flight mode
+  g_model.mixData[1].destCh = 1;
+  g_model.mixData[1].srcRaw = MIXSRC_MAX;
+  g_model.mixData[1].weight = 50;
+  // CH3 uses CH1
+  g_model.mixData[2].destCh = 2;
+  g_model.mixData[2].srcRaw = MIXSRC_FIRST_CH;
+  g_model.mixData[2].weight = 100;
+  evalMixes(1);
+  EXPECT_EQ(channelOutputs[0], 1024);
+  EXPECT_EQ(channelOutputs[2], 1024);
+  simuSetSwitch(0, 1);
+  for (int i = 0; i <= 1000; i++) {
+    evalMixes(1);
+    GTEST_ASSERT_EQ(channelOutputs[1], 512);
+    GTEST_ASSERT_LE(abs(channelOutputs[2] - channelOutputs[0]), 1);
+    if (i == 500) {
+      GTEST_ASSERT_LT(channelOutputs[0], 1024);
+      GTEST_ASSERT_GT(channelOutputs[0], -512);
+    }
+  }
+  for (int i = 0; i < 100; i++) {
+    evalMixes(1);
+  }
+  EXPECT_EQ(channelOutputs[0], -512);
+  EXPECT_EQ(channelOutputs[1], 512);
+  EXPECT_EQ(channelOutputs[2], -512);
+}
+#endif
+
 TEST_F(MixerTest, flightModeOverflow)
 {
   SYSTEM_RESET();
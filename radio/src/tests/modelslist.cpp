@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+#include "location.h"
+
+#if defined(STORAGE_MODELSLIST)
+
+#include "storage/modelslist.h"
+#include "storage/sdcard_yaml.h"
+
+class ModelsListTest : public OpenTxTest
+{
+  protected:
+    void SetUp() override
+    {
+      OpenTxTest::SetUp();
+      simuFatfsSetPaths(TESTS_BUILD_PATH "/", TESTS_BUILD_PATH "/");
+      sdCheckAndCreateDirectory(MODELS_PATH);
+      removeFiles();
+
+      writeModel("model1.yml", "Alpha", "Planes", MODULE_TYPE_XJT_PXX1,
+                 MODULE_SUBTYPE_PXX1_ACCST_D8);
+      writeModel("model2.yml", "Bravo", "Gliders", MODULE_TYPE_CROSSFIRE, 0);
+
+      // the models are read, then labels.yml and the cache are written
+      reload();
+      ASSERT_EQ(FR_OK, f_stat(LABELSLIST_CACHE_PATH, nullptr));
+      cache = readCache();
+    }
+
+    void TearDown() override
+    {
+      modelslist.clear();
+      removeFiles();
+      simuFatfsSetPaths("", "");
+    }
+
+    void removeFiles()
+    {
+      f_unlink(MODELS_PATH "/model1.yml");
+      f_unlink(MODELS_PATH "/model2.yml");
+      f_unlink(LABELSLIST_YAML_PATH);
+      f_unlink(LABELSLIST_CACHE_PATH);
+    }
+
+    void writeModel(const char * filename, const char * name,
+                    const char * labels, uint8_t type, uint8_t subType)
+    {
+      setModelDefaults();
+      strncpy(g_model.header.name, name, LEN_MODEL_NAME);
+      strncpy(g_model.header.labels, labels, LABELS_LENGTH);
+      g_model.moduleData[EXTERNAL_MODULE].type = type;
+      g_model.moduleData[EXTERNAL_MODULE].subType = subType;
+      ASSERT_EQ(nullptr, writeModelYaml(filename));
+    }
+
+    void reload()
+    {
+      modelslist.clear();
+      modelslist.load();
+    }
+
+    std::string readCache()
+    {
+      std::string data;
+      FIL file;
+      if (f_open(&file, LABELSLIST_CACHE_PATH, FA_READ) != FR_OK) return data;
+      data.resize(f_size(&file));
+      UINT read = 0;
+      f_read(&file, &data[0], data.size(), &read);
+      f_close(&file);
+      data.resize(read);
+      return data;
+    }
+
+    void writeCache(const std::string & data)
+    {
+      FIL file;
+      ASSERT_EQ(FR_OK, f_open(&file, LABELSLIST_CACHE_PATH,
+                              FA_CREATE_ALWAYS | FA_WRITE));
+      UINT written;
+      f_write(&file, data.data(), data.size(), &written);
+      f_close(&file);
+    }
+
+    ModelCell * findModel(const char * filename)
+    {
+      for (auto model : modelslist) {
+        if (!strcmp(model->modelFilename, filename)) return model;
+      }
+      return nullptr;
+    }
+
+    void checkModels()
+    {
+      ASSERT_EQ(2u, modelslist.getModelsCount());
+
+      ModelCell * alpha = findModel("model1.yml");
+      ASSERT_NE(nullptr, alpha);
+      EXPECT_STREQ("Alpha", alpha->modelName);
+      EXPECT_TRUE(modelslabels.isLabelSelected("Planes", alpha));
+      EXPECT_EQ(MODULE_TYPE_XJT_PXX1, alpha->moduleData[EXTERNAL_MODULE].type);
+      EXPECT_EQ(MODULE_SUBTYPE_PXX1_ACCST_D8,
+                alpha->moduleData[EXTERNAL_MODULE].subType);
+
+      ModelCell * bravo = findModel("model2.yml");
+      ASSERT_NE(nullptr, bravo);
+      EXPECT_STREQ("Bravo", bravo->modelName);
+      EXPECT_TRUE(modelslabels.isLabelSelected("Gliders", bravo));
+      EXPECT_EQ(MODULE_TYPE_CROSSFIRE, bravo->moduleData[EXTERNAL_MODULE].type);
+    }
+
+    std::string cache;
+};
+
+TEST_F(ModelsListTest, CacheRestoresModels)
+{
+  reload();
+  checkModels();
+  EXPECT_EQ(cache, readCache());
+}
+
+TEST_F(ModelsListTest, TruncatedCache)
+{
+  for (size_t size : {cache.size() - 1, cache.size() / 2, (size_t)10}) {
+    writeCache(cache.substr(0, size));
+    reload();
+    checkModels();
+    // labels.yml was read instead, and the cache written again
+    EXPECT_EQ(cache, readCache());
+  }
+}
+
+TEST_F(ModelsListTest, CorruptCache)
+{
+  // content which doesn't match the CRC
+  std::string data = cache;
+  data[data.size() - 1] ^= 0xFF;
+  writeCache(data);
+  reload();
+  checkModels();
+  EXPECT_EQ(cache, readCache());
+
+  // counts in the header beyond the content, which the CRC doesn't cover
+  const size_t labelsCount = 4 + 2 + 2 + sizeof(FInfoH) + 2;
+  const size_t modelsCount = labelsCount + 2;
+  for (size_t offset : {labelsCount, modelsCount}) {
+    data = cache;
+    data[offset] = data[offset + 1] = (char)0xFF;
+    writeCache(data);
+    reload();
+    checkModels();
+    EXPECT_EQ(cache, readCache());
+  }
+}
+
+#endif
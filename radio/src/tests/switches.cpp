@@ -75,6 +75,39 @@ TEST(getSwitch, OldTypeStickyCSW)
 }
 #endif
 
+TEST(evalLogicalSwitches, chainSettlesInOneTick)
+{
+  RADIO_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+
+  // L1 <- L2 <- L3 <- SA up: each switch uses the next one
+  setLogicalSwitch(0, LS_FUNC_AND, SWSRC_SW2, SWSRC_NONE);
+  setLogicalSwitch(1, LS_FUNC_AND, SWSRC_FIRST_LOGICAL_SWITCH + 2, SWSRC_NONE);
+  setLogicalSwitch(2, LS_FUNC_AND, SWSRC_FIRST_SWITCH, SWSRC_NONE);
+  // L4 toggles on each tick
+  setLogicalSwitch(3, LS_FUNC_AND, -(SWSRC_FIRST_LOGICAL_SWITCH + 3), SWSRC_NONE);
+
+  simuSetSwitch(0, 0);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), false);
+  EXPECT_EQ(getSwitch(SWSRC_FIRST_LOGICAL_SWITCH + 3), true);
+
+  simuSetSwitch(0, -1);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), true);
+  EXPECT_EQ(getSwitch(SWSRC_FIRST_LOGICAL_SWITCH + 3), false);
+
+  // nothing changes: the chain keeps its state
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), true);
+  EXPECT_EQ(getSwitch(SWSRC_FIRST_LOGICAL_SWITCH + 3), true);
+
+  simuSetSwitch(0, 0);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), false);
+}
+
 TEST(getSwitch, nullSW)
 {
   MODEL_RESET();
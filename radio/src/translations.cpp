@@ -283,6 +283,7 @@ const char STR_INTERVAL_MS[] = TR_INTERVAL_MS;
 const char STR_MEM_USED_SCRIPT[] = TR_MEM_USED_SCRIPT;
 const char STR_MEM_USED_WIDGET[] = TR_MEM_USED_WIDGET;
 const char STR_MEM_USED_EXTRA[] = TR_MEM_USED_EXTRA;
+const char STR_LUA_LOAD_LABEL[] = TR_LUA_LOAD_LABEL;
 const char STR_STACK_MIX[] = TR_STACK_MIX;
 const char STR_STACK_AUDIO[] = TR_STACK_AUDIO;
 const char STR_GPS_FIX_YES[] = TR_GPS_FIX_YES;
@@ -290,6 +291,9 @@ const char STR_GPS_FIX_NO[] = TR_GPS_FIX_NO;
 const char STR_GPS_SATS[] = TR_GPS_SATS;
 const char STR_GPS_HDOP[] = TR_GPS_HDOP;
 const char STR_STACK_MENU[] = TR_STACK_MENU;
+const char STR_DISK_CACHE_LABEL[] = TR_DISK_CACHE_LABEL;
+const char STR_DISK_CACHE_HITS[] = TR_DISK_CACHE_HITS;
+const char STR_DISK_CACHE_READAHEAD[] = TR_DISK_CACHE_READAHEAD;
 const char STR_TIMER_LABEL[]  = TR_TIMER_LABEL;
 const char STR_THROTTLE_PERCENT_LABEL[]  = TR_THROTTLE_PERCENT_LABEL;
 const char STR_BATT_LABEL[]  = TR_BATT_LABEL;
@@ -640,6 +644,7 @@ const char STR_RATIO[] = TR_RATIO;
 const char STR_FORMULA[] = TR_FORMULA;
 const char STR_CELLINDEX[] = TR_CELLINDEX;
 const char STR_LOGS[] = TR_LOGS;
+const char STR_LOGS_HIGH_RATE[] = TR_LOGS_HIGH_RATE;
 const char STR_OPTIONS[] = TR_OPTIONS;
 const char STR_FIRMWARE_OPTIONS[]  = TR_FIRMWARE_OPTIONS;
 const char STR_ALTSENSOR[] = TR_ALTSENSOR;
@@ -482,6 +482,7 @@ extern const char STR_INTERVAL_MS[];
 extern const char STR_MEM_USED_SCRIPT[];
 extern const char STR_MEM_USED_WIDGET[];
 extern const char STR_MEM_USED_EXTRA[];
+extern const char STR_LUA_LOAD_LABEL[];
 extern const char STR_STACK_MIX[];
 extern const char STR_STACK_AUDIO[];
 extern const char STR_GPS_FIX_YES[];
@@ -489,6 +490,9 @@ extern const char STR_GPS_FIX_NO[];
 extern const char STR_GPS_SATS[];
 extern const char STR_GPS_HDOP[];
 extern const char STR_STACK_MENU[];
+extern const char STR_DISK_CACHE_LABEL[];
+extern const char STR_DISK_CACHE_HITS[];
+extern const char STR_DISK_CACHE_READAHEAD[];
 extern const char STR_TIMER_LABEL[];
 extern const char STR_THROTTLE_PERCENT_LABEL[];
 extern const char STR_BATT_LABEL[];
@@ -1054,6 +1058,7 @@ extern const char STR_RATIO[];
 extern const char STR_FORMULA[];
 extern const char STR_CELLINDEX[];
 extern const char STR_LOGS[];
+extern const char STR_LOGS_HIGH_RATE[];
 extern const char STR_OPTIONS[];
 extern const char STR_FIRMWARE_OPTIONS[];
 extern const char STR_ALTSENSOR[];
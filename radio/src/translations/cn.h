@@ -430,6 +430,7 @@
 #define TR_MEM_USED_SCRIPT             "脚本(B): "
 #define TR_MEM_USED_WIDGET             "小部件(B): "
 #define TR_MEM_USED_EXTRA              "附加(B): "
+#define TR_LUA_LOAD_LABEL              "Lua load"
 #define TR_STACK_MIX                   "混控: "
 #define TR_STACK_AUDIO                 "音频: "
 #define TR_GPS_FIX_YES                 "修正: 是"
@@ -437,6 +438,9 @@
 #define TR_GPS_SATS                    "卫星: "
 #define TR_GPS_HDOP                    "Hdop: "
 #define TR_STACK_MENU                  "选单: "
+#define TR_DISK_CACHE_LABEL            "SD cache"
+#define TR_DISK_CACHE_HITS             "Hits(%): "
+#define TR_DISK_CACHE_READAHEAD        "Read-ahead: "
 #define TR_TIMER_LABEL                 "Timer"
 #define TR_THROTTLE_PERCENT_LABEL      "Throttle %"
 #define TR_BATT_LABEL                  "Battery"
@@ -1090,6 +1094,7 @@
 #define TR_FORMULA                     "公式"
 #define TR_CELLINDEX                   "单节电池编号"
 #define TR_LOGS                        "日志"
+#define TR_LOGS_HIGH_RATE              "High rate"
 #define TR_OPTIONS                     "选项"
 #define TR_FIRMWARE_OPTIONS            "固件选项"
 
@@ -446,6 +446,7 @@
 #define TR_MEM_USED_SCRIPT         "Script(B): "
 #define TR_MEM_USED_WIDGET         "Widget(B): "
 #define TR_MEM_USED_EXTRA          "Extra(B): "
+#define TR_LUA_LOAD_LABEL          "Lua load"
 #define TR_STACK_MIX                   "Mix: "
 #define TR_STACK_AUDIO                 "Audio: "
 #define TR_GPS_FIX_YES                 "Fix: Yes"
@@ -453,6 +454,9 @@
 #define TR_GPS_SATS                    "Sats: "
 #define TR_GPS_HDOP                    "Hdop: "
 #define TR_STACK_MENU                  "Menu: "
+#define TR_DISK_CACHE_LABEL            "SD cache"
+#define TR_DISK_CACHE_HITS             "Hits(%): "
+#define TR_DISK_CACHE_READAHEAD        "Read-ahead: "
 #define TR_TIMER_LABEL                 "Časovač"
 #define TR_THROTTLE_PERCENT_LABEL      "Plyn %"
 #define TR_BATT_LABEL                  "Baterie"
@@ -1111,6 +1115,7 @@
 #define TR_FORMULA                     "Operace"
 #define TR_CELLINDEX                   "Článek"
 #define TR_LOGS                        "Logovat"
+#define TR_LOGS_HIGH_RATE              "High rate"
 #define TR_OPTIONS                     "Možnosti"
 #define TR_FIRMWARE_OPTIONS            "Možnosti firmwaru"
 
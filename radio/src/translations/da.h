@@ -440,6 +440,7 @@
 #define TR_MEM_USED_SCRIPT             "Script(B): "
 #define TR_MEM_USED_WIDGET             "Widget(B): "
 #define TR_MEM_USED_EXTRA              "Extra(B): "
+#define TR_LUA_LOAD_LABEL              "Lua load"
 #define TR_STACK_MIX                   "Mix: "
 #define TR_STACK_AUDIO                 "Audio: "
 #define TR_GPS_FIX_YES                 "Fix: Ja"
@@ -447,6 +448,9 @@
 #define TR_GPS_SATS                    TR("Sat.: ", "Satelitter:")
 #define TR_GPS_HDOP                    "Hdop: "
 #define TR_STACK_MENU                  "Menu: "
+#define TR_DISK_CACHE_LABEL            "SD cache"
+#define TR_DISK_CACHE_HITS             "Hits(%): "
+#define TR_DISK_CACHE_READAHEAD        "Read-ahead: "
 #define TR_TIMER_LABEL                 "Tid"
 #define TR_THROTTLE_PERCENT_LABEL      "Gas %"
 #define TR_BATT_LABEL                  "Batteri"
@@ -1104,6 +1108,7 @@
 #define TR_FORMULA                     "Formel"
 #define TR_CELLINDEX                   "Celle indeks"
 #define TR_LOGS                        "Log"
+#define TR_LOGS_HIGH_RATE              "High rate"
 #define TR_OPTIONS                     "Tilvalg"
 #define TR_FIRMWARE_OPTIONS            "Firmware tilvalg"
 
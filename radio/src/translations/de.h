@@ -437,6 +437,7 @@
 #define TR_MEM_USED_SCRIPT         "Script(B): "
 #define TR_MEM_USED_WIDGET         "Widget(B): "
 #define TR_MEM_USED_EXTRA          "Extra(B): "
+#define TR_LUA_LOAD_LABEL          "Lua load"
 #define TR_STACK_MIX                   "Mix: "
 #define TR_STACK_AUDIO                 "Audio: "
 #define TR_GPS_FIX_YES                 "Fix: Yes"
@@ -444,6 +445,9 @@
 #define TR_GPS_SATS                    "Sats: "
 #define TR_GPS_HDOP                    "Hdop: "
 #define TR_STACK_MENU                  "Menü: "
+#define TR_DISK_CACHE_LABEL            "SD cache"
+#define TR_DISK_CACHE_HITS             "Hits(%): "
+#define TR_DISK_CACHE_READAHEAD        "Read-ahead: "
 #define TR_TIMER_LABEL                 "Timer"
 #define TR_THROTTLE_PERCENT_LABEL      "Gas %"
 #define TR_BATT_LABEL                  "Battery"
@@ -1107,6 +1111,7 @@
 #define TR_FORMULA                     "Formel"
 #define TR_CELLINDEX                   "Zellenindex"
 #define TR_LOGS                        "Log Daten"
+#define TR_LOGS_HIGH_RATE              "High rate"
 #define TR_OPTIONS                     "Optionen"
 #define TR_FIRMWARE_OPTIONS            "Firmwareoptionen"
 
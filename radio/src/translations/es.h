@@ -427,6 +427,7 @@
 #define TR_MEM_USED_SCRIPT         "Script(B): "
 #define TR_MEM_USED_WIDGET         "Widget(B): "
 #define TR_MEM_USED_EXTRA          "Extra(B): "
+#define TR_LUA_LOAD_LABEL          "Lua load"
 #define TR_STACK_MIX                   "Mix: "
 #define TR_STACK_AUDIO                 "Audio: "
 #define TR_GPS_FIX_YES                 "Fix: Yes"
@@ -434,6 +435,9 @@
 #define TR_GPS_SATS                    "Sats: "
 #define TR_GPS_HDOP                    "Hdop: "
 #define TR_STACK_MENU                  "Menu: "
+#define TR_DISK_CACHE_LABEL            "SD cache"
+#define TR_DISK_CACHE_HITS             "Hits(%): "
+#define TR_DISK_CACHE_READAHEAD        "Read-ahead: "
 #define TR_TIMER_LABEL                "Timer"
 #define TR_THROTTLE_PERCENT_LABEL     "Throttle %"
 #define TR_BATT_LABEL                 "Battery"
@@ -1102,6 +1106,7 @@
 #define TR_FORMULA             "Fórmula"
 #define TR_CELLINDEX           "Cell index"
 #define TR_LOGS                "Logs"
+#define TR_LOGS_HIGH_RATE      "High rate"
 #define TR_OPTIONS             "Opciones"
 #define TR_FIRMWARE_OPTIONS    "Opciones firmware"
 
@@ -443,6 +443,7 @@
 #define TR_MEM_USED_SCRIPT             "Script(B): "
 #define TR_MEM_USED_WIDGET             "Widget(B): "
 #define TR_MEM_USED_EXTRA              "Extra(B): "
+#define TR_LUA_LOAD_LABEL              "Lua load"
 #define TR_STACK_MIX                   "Mixeurs: "
 #define TR_STACK_AUDIO                 "Audio: "
 #define TR_GPS_FIX_YES                 "Fix: Oui"
@@ -450,6 +451,9 @@
 #define TR_GPS_SATS                    "Sats: "
 #define TR_GPS_HDOP                    "Hdop: "
 #define TR_STACK_MENU                  "Menu: "
+#define TR_DISK_CACHE_LABEL            "SD cache"
+#define TR_DISK_CACHE_HITS             "Hits(%): "
+#define TR_DISK_CACHE_READAHEAD        "Read-ahead: "
 #define TR_TIMER_LABEL                 "Chrono"
 #define TR_THROTTLE_PERCENT_LABEL      "Gaz %"
 #define TR_BATT_LABEL                  "Batterie"
@@ -1116,6 +1120,7 @@
 #define TR_FORMULA                     "Formule"
 #define TR_CELLINDEX                   "Index élém."
 #define TR_LOGS                        "Logs"
+#define TR_LOGS_HIGH_RATE              "High rate"
 #define TR_OPTIONS                     "Options"
 #define TR_FIRMWARE_OPTIONS            "Options Firmware"
 
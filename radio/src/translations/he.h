@@ -439,6 +439,7 @@
 #define TR_MEM_USED_SCRIPT             "Script(B): "
 #define TR_MEM_USED_WIDGET             "Widget(B): "
 #define TR_MEM_USED_EXTRA              "Extra(B): "
+#define TR_LUA_LOAD_LABEL              "Lua load"
 #define TR_STACK_MIX                   "Mix: "
 #define TR_STACK_AUDIO                 "Audio: "
 #define TR_GPS_FIX_YES                 "Fix: Yes"
@@ -446,6 +447,9 @@
 #define TR_GPS_SATS                    "Sats: "
 #define TR_GPS_HDOP                    "Hdop: "
 #define TR_STACK_MENU                  "Menu: "
+#define TR_DISK_CACHE_LABEL            "SD cache"
+#define TR_DISK_CACHE_HITS             "Hits(%): "
+#define TR_DISK_CACHE_READAHEAD        "Read-ahead: "
 #define TR_TIMER_LABEL                 "שעון"
 #define TR_THROTTLE_PERCENT_LABEL      "מצערת %"
 #define TR_BATT_LABEL                  "סוללה"
@@ -1108,6 +1112,7 @@
 #define TR_FORMULA                     "נוסחה"
 #define TR_CELLINDEX                   "מיקום תא"
 #define TR_LOGS                        "לוגים"
+#define TR_LOGS_HIGH_RATE              "High rate"
 #define TR_OPTIONS                     "אופציות"
 #define TR_FIRMWARE_OPTIONS            "אופציןת קושחה"
 
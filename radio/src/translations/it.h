@@ -435,6 +435,7 @@
 #define TR_MEM_USED_SCRIPT              "Script(B): "
 #define TR_MEM_USED_WIDGET              "Widget(B): "
 #define TR_MEM_USED_EXTRA               "Extra(B): "
+#define TR_LUA_LOAD_LABEL               "Lua load"
 #define TR_STACK_MIX                    "Mix: "
 #define TR_STACK_AUDIO                  "Audio: "
 #define TR_GPS_FIX_YES                  "Fix: Sì"
@@ -442,6 +443,9 @@
 #define TR_GPS_SATS                     "Sats: "
 #define TR_GPS_HDOP                     "Hdop: "
 #define TR_STACK_MENU                   "Menu: "
+#define TR_DISK_CACHE_LABEL             "SD cache"
+#define TR_DISK_CACHE_HITS              "Hits(%): "
+#define TR_DISK_CACHE_READAHEAD         "Read-ahead: "
 #define TR_TIMER_LABEL                  "Timer"
 #define TR_THROTTLE_PERCENT_LABEL       "% Motore"
 #define TR_BATT_LABEL                   "Batteria"
@@ -1099,6 +1103,7 @@
 #define TR_FORMULA                      "Formula"
 #define TR_CELLINDEX                    "Indice cella"
 #define TR_LOGS                         "Logs"
+#define TR_LOGS_HIGH_RATE               "High rate"
 #define TR_OPTIONS                      "Opzioni"
 #define TR_FIRMWARE_OPTIONS             "Opzioni firmware"
 
@@ -432,6 +432,7 @@
 #define TR_MEM_USED_SCRIPT            "Skrypt(B): "
 #define TR_MEM_USED_WIDGET            "Widget(B): "
 #define TR_MEM_USED_EXTRA             "Ekstra(B): "
+#define TR_LUA_LOAD_LABEL             "Lua load"
 #define TR_STACK_MIX                  "Mix: "
 #define TR_STACK_AUDIO                "Audio: "
 #define TR_GPS_FIX_YES                "Fix: Tak"
@@ -439,6 +440,9 @@
 #define TR_GPS_SATS                   "Sat: "
 #define TR_GPS_HDOP                   "Hdop: "
 #define TR_STACK_MENU                 "Menu: "
+#define TR_DISK_CACHE_LABEL           "SD cache"
+#define TR_DISK_CACHE_HITS            "Hits(%): "
+#define TR_DISK_CACHE_READAHEAD       "Read-ahead: "
 #define TR_TIMER_LABEL                "Timer"
 #define TR_THROTTLE_PERCENT_LABEL     "Throttle %"
 #define TR_BATT_LABEL                 "Battery"
@@ -1097,6 +1101,7 @@
 #define TR_FORMULA             "Formuła"
 #define TR_CELLINDEX           "Cell index"
 #define TR_LOGS                "Logi"
+#define TR_LOGS_HIGH_RATE      "High rate"
 #define TR_OPTIONS             "Opcje  "
 #define TR_FIRMWARE_OPTIONS    "Opcje firmware"
 
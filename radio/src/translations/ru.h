@@ -437,6 +437,7 @@
 #define TR_MEM_USED_SCRIPT         "Скрипт(B): "
 #define TR_MEM_USED_WIDGET         "Виджет(B): "
 #define TR_MEM_USED_EXTRA          "Extra(B): "
+#define TR_LUA_LOAD_LABEL          "Lua load"
 #define TR_STACK_MIX                   "Mix: "
 #define TR_STACK_AUDIO                 "Аудио: "
 #define TR_GPS_FIX_YES                 "Фикс: Да"
@@ -444,6 +445,9 @@
 #define TR_GPS_SATS                    "Спутники: "
 #define TR_GPS_HDOP                    "Hdop: "
 #define TR_STACK_MENU                  "Меню: "
+#define TR_DISK_CACHE_LABEL            "SD cache"
+#define TR_DISK_CACHE_HITS             "Hits(%): "
+#define TR_DISK_CACHE_READAHEAD        "Read-ahead: "
 #define TR_TIMER_LABEL                 "Таймер"
 #define TR_THROTTLE_PERCENT_LABEL      "Газ %"
 #define TR_BATT_LABEL                  "АКБ"
@@ -1102,6 +1106,7 @@
 #define TR_FORMULA                     "Формула"
 #define TR_CELLINDEX                   "Инд. ячейки"
 #define TR_LOGS                        "Логи"
+#define TR_LOGS_HIGH_RATE              "High rate"
 #define TR_OPTIONS                     "Опции"
 #define TR_FIRMWARE_OPTIONS            "Опции ПО"
 
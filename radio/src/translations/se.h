@@ -456,6 +456,7 @@
 #define TR_MEM_USED_SCRIPT              "Skript(B): "
 #define TR_MEM_USED_WIDGET              "Widget(B): "
 #define TR_MEM_USED_EXTRA               "Extra(B): "
+#define TR_LUA_LOAD_LABEL               "Lua load"
 #define TR_STACK_MIX                    "Mix: "
 #define TR_STACK_AUDIO                  "Audio: "
 #define TR_GPS_FIX_YES                  "Fix: Nej"
@@ -463,6 +464,9 @@
 #define TR_GPS_SATS                     "Sats: "
 #define TR_GPS_HDOP                     "Hdop: "
 #define TR_STACK_MENU                   "Meny: "
+#define TR_DISK_CACHE_LABEL             "SD cache"
+#define TR_DISK_CACHE_HITS              "Hits(%): "
+#define TR_DISK_CACHE_READAHEAD         "Read-ahead: "
 #define TR_TIMER_LABEL                  "Timer"
 #define TR_THROTTLE_PERCENT_LABEL       "Gas %"
 #define TR_BATT_LABEL                   "Batteri"
@@ -1129,6 +1133,7 @@
 #define TR_FORMULA                      "Formel"
 #define TR_CELLINDEX                    "Cellindex"
 #define TR_LOGS                         "Logga"
+#define TR_LOGS_HIGH_RATE               "High rate"
 #define TR_OPTIONS                      "Alternativ"
 #define TR_FIRMWARE_OPTIONS             "Firmwarefunktioner"
 
@@ -427,6 +427,7 @@
 #define TR_MEM_USED_SCRIPT         "Скрипт(B): "
 #define TR_MEM_USED_WIDGET         "Віджет(B): "
 #define TR_MEM_USED_EXTRA          "Extra(B): "
+#define TR_LUA_LOAD_LABEL          "Lua load"
 #define TR_STACK_MIX                   "Mix: "
 #define TR_STACK_AUDIO                 "Аудіо: "
 #define TR_GPS_FIX_YES                 "Фіксація: Так"
@@ -434,6 +435,9 @@
 #define TR_GPS_SATS                    "Супутн: "
 #define TR_GPS_HDOP                    "Hdop: "		/* use english */
 #define TR_STACK_MENU                  "Меню: "
+#define TR_DISK_CACHE_LABEL            "SD cache"
+#define TR_DISK_CACHE_HITS             "Hits(%): "
+#define TR_DISK_CACHE_READAHEAD        "Read-ahead: "
 #define TR_TIMER_LABEL                 "Таймер"
 #define TR_THROTTLE_PERCENT_LABEL      "Газ %"
 #define TR_BATT_LABEL                  "Battery"		/* use english */
@@ -1076,6 +1080,7 @@
 #define TR_FORMULA                     "Формула"
 #define TR_CELLINDEX                   "Номер комірки"
 #define TR_LOGS                        "Логи"
+#define TR_LOGS_HIGH_RATE              "High rate"
 #define TR_OPTIONS                     "Опції"
 #define TR_FIRMWARE_OPTIONS            "Опції Firmware"
 
@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+
+# Converts the PCM WAV files of a sound pack to mono IMA-ADPCM (4 bits
+# per sample), which the radio decodes while playing: the SD card
+# traffic of the voice prompts is divided by 4.
+#
+# Usage: wav2adpcm.py <input file or directory> <output directory>
+
+import argparse
+import os
+import struct
+import sys
+import wave
+
+STEPS = [
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37,
+    41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173,
+    190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658,
+    724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894,
+    6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289,
+    16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+]
+
+INDEXES = [-1, -1, -1, -1, 2, 4, 6, 8]
+
+CODEC_ID_IMA_ADPCM = 0x11
+HEADER_SIZE = 4
+
+
+def block_size(rate):
+    # the usual block sizes: 32ms at most
+    if rate <= 11025:
+        return 256
+    if rate <= 22050:
+        return 512
+    return 1024
+
+
+def decode(code, predictor, index):
+    step = STEPS[index]
+    diff = step >> 3
+    if code & 4:
+        diff += step
+    if code & 2:
+        diff += step >> 1
+    if code & 1:
+        diff += step >> 2
+    predictor += -diff if code & 8 else diff
+    predictor = max(-32768, min(32767, predictor))
+    index = max(0, min(len(STEPS) - 1, index + INDEXES[code & 7]))
+    return predictor, index
+
+
+def encode(samples, blocksize):
+    samples_per_block = (blocksize - HEADER_SIZE) * 2 + 1
+    out = bytearray()
+    index = 0
+    for start in range(0, len(samples), samples_per_block):
+        block = samples[start:start + samples_per_block]
+        block += [block[-1]] * (samples_per_block - len(block))
+        predictor = block[0]
+        out += struct.pack("<hBB", predictor, index, 0)
+        codes = []
+        for sample in block[1:]:
+            diff = sample - predictor
+            step = STEPS[index]
+            code = 0
+            if diff < 0:
+                code = 8
+                diff = -diff
+            # rounded to the nearest quantizer level
+            diff += step >> 3
+            if diff >= step:
+                code |= 4
+                diff -= step
+            if diff >= step >> 1:
+                code |= 2
+                diff -= step >> 1
+            if diff >= step >> 2:
+                code |= 1
+            predictor, index = decode(code, predictor, index)
+            codes.append(code)
+        for i in range(0, len(codes), 2):
+            out.append(codes[i] | (codes[i + 1] << 4))
+    return out, samples_per_block
+
+
+def read_pcm(filename):
+    with wave.open(filename, "rb") as f:
+        if f.getsampwidth() != 2:
+            raise ValueError("16-bit PCM expected")
+        channels = f.getnchannels()
+        rate = f.getframerate()
+        frames = f.readframes(f.getnframes())
+    values = struct.unpack("<%dh" % (len(frames) // 2), frames)
+    # stereo files are mixed down
+    samples = [sum(values[i:i + channels]) // channels
+               for i in range(0, len(values), channels)]
+    return samples, rate
+
+
+def write_adpcm(filename, samples, rate):
+    blocksize = block_size(rate)
+    data, samples_per_block = encode(samples, blocksize)
+    byte_rate = rate * blocksize // samples_per_block
+    # the radio expects the "fmt " chunk first
+    fmt = struct.pack("<HHIIHHHH", CODEC_ID_IMA_ADPCM, 1, rate, byte_rate,
+                      blocksize, 4, 2, samples_per_block)
+    fact = struct.pack("<I", len(samples))
+    riff = b"WAVE"
+    riff += b"fmt " + struct.pack("<I", len(fmt)) + fmt
+    riff += b"fact" + struct.pack("<I", len(fact)) + fact
+    riff += b"data" + struct.pack("<I", len(data)) + data
+    with open(filename, "wb") as f:
+        f.write(b"RIFF" + struct.pack("<I", len(riff)) + riff)
+    return len(data)
+
+
+def convert(src, dst):
+    try:
+        samples, rate = read_pcm(src)
+    except (wave.Error, ValueError, EOFError) as e:
+        print("%s: skipped (%s)" % (src, e))
+        return 0, 0
+    if not samples:
+        return 0, 0
+    size = write_adpcm(dst, samples, rate)
+    return len(samples) * 2, size
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Sound pack to IMA-ADPCM converter")
+    parser.add_argument("input", help="WAV file or sound pack directory")
+    parser.add_argument("output", help="output directory")
+    args = parser.parse_args()
+
+    files = []
+    if os.path.isdir(args.input):
+        for root, _, names in os.walk(args.input):
+            for name in sorted(names):
+                if name.lower().endswith(".wav"):
+                    src = os.path.join(root, name)
+                    files.append((src, os.path.relpath(src, args.input)))
+    else:
+        files.append((args.input, os.path.basename(args.input)))
+
+    pcm_size = adpcm_size = 0
+    for src, rel in files:
+        dst = os.path.join(args.output, rel)
+        os.makedirs(os.path.dirname(dst) or ".", exist_ok=True)
+        before, after = convert(src, dst)
+        pcm_size += before
+        adpcm_size += after
+
+    if pcm_size:
+        print("%d files, %d -> %d bytes of samples (%.1f%%)"
+              % (len(files), pcm_size, adpcm_size, adpcm_size * 100.0 / pcm_size))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())